@@ -52,6 +52,11 @@ add_custom_target(tests-radio
   DEPENDS gtests-radio
   )
 
+add_custom_target(benchmarks-radio
+  COMMAND ${CMAKE_CURRENT_BINARY_DIR}/bench-radio --gtest_output=xml:${CMAKE_CURRENT_BINARY_DIR}/bench-radio.xml
+  DEPENDS bench-radio
+  )
+
 if(Qt5Core_FOUND AND NOT DISABLE_COMPANION)
   add_subdirectory(${COMPANION_SRC_DIRECTORY})
   add_custom_target(tests-companion
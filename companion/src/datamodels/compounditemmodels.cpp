@@ -24,6 +24,8 @@
 #include "modeldata.h"
 #include "adjustmentreference.h"
 
+#include <climits>
+
 // static
 QString AbstractItemModel::idToString(const int value)
 {
@@ -95,6 +97,62 @@ void AbstractStaticItemModel::loadItemList()
   itemList.clear();
 };
 
+//
+// AbstractDynamicItemModel
+//
+
+//  Refreshes the items depending on the entities changed by the event, or all of them on a system refresh,
+//  and signals the changed rows as one range rather than item by item
+void AbstractDynamicItemModel::updateItems(const int event, const int first, const int count)
+{
+  if (!doUpdate(event))
+    return;
+
+  emit aboutToBeUpdated();
+
+  const bool refreshAll = event & IMUE_SystemRefresh;
+  const int last = count < 0 ? INT_MAX : first + count - 1;
+  int top = rowCount();
+  int bottom = -1;
+
+  const bool blocked = blockSignals(true);
+
+  for (int i = 0; i < rowCount(); ++i) {
+    const ItemDependency & dep = itemDependencies.at(i);
+    if (refreshAll || ((dep.event & event) && dep.entity >= first && dep.entity <= last)) {
+      if (updateItem(item(i))) {
+        top = qMin(top, i);
+        bottom = i;
+      }
+    }
+  }
+
+  blockSignals(blocked);
+
+  if (bottom >= 0)
+    emit dataChanged(index(top, 0), index(bottom, 0));
+
+  emit updateComplete();
+}
+
+// static
+bool AbstractDynamicItemModel::setItemTextAndAvailable(QStandardItem * item, const QString & text, const bool available)
+{
+  bool changed = false;
+
+  if (item->text() != text) {
+    item->setText(text);
+    changed = true;
+  }
+
+  if (item->data(IMDR_Available) != QVariant(available)) {
+    item->setData(available, IMDR_Available);
+    changed = true;
+  }
+
+  return changed;
+}
+
 //
 // RawSourceItemModel
 //
@@ -124,10 +182,40 @@ RawSourceItemModel::RawSourceItemModel(const GeneralSettings * const generalSett
   addItems(SOURCE_TYPE_GVAR,           RawSource::GVarsGroup,    firmware->getCapability(Gvars));
 }
 
-void RawSourceItemModel::setDynamicItemData(QStandardItem * item, const RawSource & src) const
+bool RawSourceItemModel::setDynamicItemData(QStandardItem * item, const RawSource & src) const
 {
-  item->setText(src.toString(modelData, generalSettings, boardType));
-  item->setData(src.isAvailable(modelData, generalSettings, boardType), IMDR_Available);
+  return setItemTextAndAvailable(item, src.toString(modelData, generalSettings, boardType),
+                                 src.isAvailable(modelData, generalSettings, boardType));
+}
+
+bool RawSourceItemModel::updateItem(QStandardItem * item)
+{
+  return setDynamicItemData(item, RawSource(item->data(IMDR_Id).toInt()));
+}
+
+// static
+AbstractDynamicItemModel::ItemDependency RawSourceItemModel::itemDependency(const RawSource & src)
+{
+  switch (src.type) {
+    case SOURCE_TYPE_VIRTUAL_INPUT:
+      return ItemDependency(IMUE_Inputs, src.index);
+    case SOURCE_TYPE_FUNCTIONSWITCH:
+      return ItemDependency(IMUE_FunctionSwitches, src.index);
+    case SOURCE_TYPE_CUSTOM_SWITCH:
+      return ItemDependency(IMUE_LogicalSwitches, src.index);
+    case SOURCE_TYPE_CH:
+      return ItemDependency(IMUE_Channels, src.index);
+    case SOURCE_TYPE_SPECIAL:
+      if (src.index >= SOURCE_TYPE_SPECIAL_FIRST_TIMER && src.index <= SOURCE_TYPE_SPECIAL_LAST_TIMER)
+        return ItemDependency(IMUE_Timers, src.index - SOURCE_TYPE_SPECIAL_FIRST_TIMER);
+      return ItemDependency();
+    case SOURCE_TYPE_TELEMETRY:
+      return ItemDependency(IMUE_TeleSensors, src.index / 3);
+    case SOURCE_TYPE_GVAR:
+      return ItemDependency(IMUE_GVars, src.index);
+    default:
+      return ItemDependency();
+  }
 }
 
 void RawSourceItemModel::addItems(const RawSourceType & type, const int group, const int count, const int start)
@@ -140,19 +228,18 @@ void RawSourceItemModel::addItems(const RawSourceType & type, const int group, c
     modelItem->setData(group, IMDR_Flags);
     setDynamicItemData(modelItem, src);
     appendRow(modelItem);
+    itemDependencies.append(itemDependency(src));
   }
 }
 
 void RawSourceItemModel::update(const int event)
 {
-  if (doUpdate(event)) {
-    emit aboutToBeUpdated();
-
-    for (int i = 0; i < rowCount(); ++i)
-      setDynamicItemData(item(i), RawSource(item(i)->data(IMDR_Id).toInt()));
+  updateItems(event);
+}
 
-    emit updateComplete();
-  }
+void RawSourceItemModel::updateEntities(const int event, const int first, const int count)
+{
+  updateItems(event, first, count);
 }
 
 //
@@ -192,10 +279,35 @@ RawSwitchItemModel::RawSwitchItemModel(const GeneralSettings * const generalSett
   addItems(SWITCH_TYPE_ACT,            1);
 }
 
-void RawSwitchItemModel::setDynamicItemData(QStandardItem * item, const RawSwitch & rsw) const
+bool RawSwitchItemModel::setDynamicItemData(QStandardItem * item, const RawSwitch & rsw) const
 {
-  item->setText(rsw.toString(boardType, generalSettings, modelData));
-  item->setData(rsw.isAvailable(modelData, generalSettings, boardType), IMDR_Available);
+  return setItemTextAndAvailable(item, rsw.toString(boardType, generalSettings, modelData),
+                                 rsw.isAvailable(modelData, generalSettings, boardType));
+}
+
+bool RawSwitchItemModel::updateItem(QStandardItem * item)
+{
+  return setDynamicItemData(item, RawSwitch(item->data(IMDR_Id).toInt()));
+}
+
+// static
+AbstractDynamicItemModel::ItemDependency RawSwitchItemModel::itemDependency(const RawSwitch & rsw)
+{
+  // one-based indices, negative for the NOT (!) switches
+  const int idx = abs(rsw.index) - 1;
+
+  switch (rsw.type) {
+    case SWITCH_TYPE_FUNCTIONSWITCH:
+      return ItemDependency(IMUE_FunctionSwitches, idx / 3);
+    case SWITCH_TYPE_VIRTUAL:
+      return ItemDependency(IMUE_LogicalSwitches, idx);
+    case SWITCH_TYPE_FLIGHT_MODE:
+      return ItemDependency(IMUE_FlightModes, idx);
+    case SWITCH_TYPE_SENSOR:
+      return ItemDependency(IMUE_TeleSensors, idx);
+    default:
+      return ItemDependency();
+  }
 }
 
 void RawSwitchItemModel::addItems(const RawSwitchType & type, int count)
@@ -235,19 +347,18 @@ void RawSwitchItemModel::addItems(const RawSwitchType & type, int count)
     modelItem->setData(context, IMDR_Flags);
     setDynamicItemData(modelItem, rs);
     appendRow(modelItem);
+    itemDependencies.append(itemDependency(rs));
   }
 }
 
 void RawSwitchItemModel::update(const int event)
 {
-  if (doUpdate(event)) {
-    emit aboutToBeUpdated();
-
-    for (int i = 0; i < rowCount(); ++i)
-      setDynamicItemData(item(i), RawSwitch(item(i)->data(IMDR_Id).toInt()));
+  updateItems(event);
+}
 
-    emit updateComplete();
-  }
+void RawSwitchItemModel::updateEntities(const int event, const int first, const int count)
+{
+  updateItems(event, first, count);
 }
 
 //
@@ -738,6 +849,13 @@ void CompoundItemModelFactory::update(const int event)
   }
 }
 
+void CompoundItemModelFactory::update(const int event, const int first, const int count)
+{
+  foreach (AbstractItemModel * itemModel, registeredItemModels) {
+    itemModel->updateEntities(event, first, count);
+  }
+}
+
 void CompoundItemModelFactory::dumpAllItemModelContents() const
 {
   foreach (AbstractItemModel * itemModel, registeredItemModels) {
@@ -114,6 +114,10 @@ class AbstractItemModel: public QStandardItemModel
 
     static void dumpItemModelContents(AbstractItemModel * itemModel);
 
+    //  update only the items depending on count entities from first (zero based) of the event types,
+    //  to the last entity if count < 0
+    virtual void updateEntities(const int event, const int first, const int count = 1) { update(event); }
+
   public slots:
     virtual void update(const int event = IMUE_SystemRefresh) = 0;
 
@@ -182,6 +186,24 @@ class AbstractDynamicItemModel: public AbstractItemModel
   signals:
     void aboutToBeUpdated();
     void updateComplete();
+
+  protected:
+    //  the update event changing an item and the index of the entity it depends on
+    //  IMUE_None when only a system refresh can change it
+    struct ItemDependency
+    {
+      int event;
+      int entity;
+
+      ItemDependency() : event(IMUE_None), entity(0) {}
+      ItemDependency(int p_event, int p_entity) : event(p_event), entity(p_entity) {}
+    };
+
+    QVector<ItemDependency> itemDependencies;   //  one per row
+
+    void updateItems(const int event, const int first = 0, const int count = -1);
+    virtual bool updateItem(QStandardItem * item) { return false; }
+    static bool setItemTextAndAvailable(QStandardItem * item, const QString & text, const bool available);
 };
 
 class RawSourceItemModel: public AbstractDynamicItemModel
@@ -192,11 +214,15 @@ class RawSourceItemModel: public AbstractDynamicItemModel
                                 Firmware * firmware, const Boards * const board, const Board::Type boardType);
     virtual ~RawSourceItemModel() {};
 
+    virtual void updateEntities(const int event, const int first, const int count = 1) override;
+
   public slots:
     virtual void update(const int event = IMUE_SystemRefresh) override;
 
   protected:
-    virtual void setDynamicItemData(QStandardItem * item, const RawSource & src) const;
+    virtual bool setDynamicItemData(QStandardItem * item, const RawSource & src) const;
+    virtual bool updateItem(QStandardItem * item) override;
+    static ItemDependency itemDependency(const RawSource & src);
     void addItems(const RawSourceType & type, const int group, const int count, const int start = 0);
 };
 
@@ -208,11 +234,15 @@ class RawSwitchItemModel: public AbstractDynamicItemModel
                                 Firmware * firmware, const Boards * const board, const Board::Type boardType);
     virtual ~RawSwitchItemModel() {};
 
+    virtual void updateEntities(const int event, const int first, const int count = 1) override;
+
   public slots:
     virtual void update(const int event = IMUE_SystemRefresh) override;
 
   protected:
-    virtual void setDynamicItemData(QStandardItem * item, const RawSwitch & rsw) const;
+    virtual bool setDynamicItemData(QStandardItem * item, const RawSwitch & rsw) const;
+    virtual bool updateItem(QStandardItem * item) override;
+    static ItemDependency itemDependency(const RawSwitch & rsw);
     void addItems(const RawSwitchType & type, int count);
 };
 
@@ -366,6 +396,7 @@ class CompoundItemModelFactory
     AbstractItemModel * getItemModel(const int id) const;
     AbstractItemModel * getItemModel(const QString name) const;
     void update(const int event = AbstractItemModel::IMUE_SystemRefresh);
+    void update(const int event, const int first, const int count = 1);
     void dumpAllItemModelContents() const;
 
   protected:
@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logdata.h"
+
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#define LOG_CHUNK_MIN_SIZE    (256 * 1024)
+#define LOG_MAX_DIGITS        18
+
+constexpr qint64 LogData::INVALID_TIMESTAMP;
+
+struct LogData::Chunk {
+  const char * begin;
+  const char * end;
+  qint64 offset;
+  QVector<qint64> timestamps;
+  QVector<qint64> lineOffsets;
+  QVector<quint32> lineLengths;
+  QVector<Column> columns;
+  int lines;
+  int errors;
+};
+
+enum NumberKind {
+  NUMBER_INVALID,
+  NUMBER_INT,
+  NUMBER_FLOAT
+};
+
+static const double powersOf10[LOG_MAX_DIGITS + 1] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+};
+
+static inline bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static NumberKind parseNumber(const char * s, const char * e, qint32 & i, float & f)
+{
+  while (s < e && isBlank(*s)) s++;
+  while (e > s && isBlank(e[-1])) e--;
+
+  // empty fields always read as 0
+  if (s == e) {
+    i = 0;
+    return NUMBER_INT;
+  }
+
+  const char * p = s;
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = (*p++ == '-');
+  }
+
+  quint64 mantissa = 0;
+  int digits = 0;
+  int decimals = 0;
+  bool dot = false;
+  bool slow = false;
+
+  for (; p < e; p++) {
+    char c = *p;
+    if (c >= '0' && c <= '9') {
+      if (digits < LOG_MAX_DIGITS) {
+        mantissa = mantissa * 10 + (c - '0');
+        digits++;
+        if (dot) decimals++;
+      }
+      else if (!dot) {
+        slow = true;
+        break;
+      }
+    }
+    else if (c == '.' && !dot) {
+      dot = true;
+    }
+    else {
+      // exponent, or not a number at all
+      slow = true;
+      break;
+    }
+  }
+
+  if (slow) {
+    bool ok;
+    double value = QByteArray::fromRawData(s, e - s).toDouble(&ok);
+    if (!ok) return NUMBER_INVALID;
+    f = value;
+    return NUMBER_FLOAT;
+  }
+
+  if (digits == 0) {
+    return NUMBER_INVALID;
+  }
+
+  if (!dot) {
+    qint64 value = negative ? -(qint64)mantissa : (qint64)mantissa;
+    if (value >= std::numeric_limits<qint32>::min() && value <= std::numeric_limits<qint32>::max()) {
+      i = value;
+      return NUMBER_INT;
+    }
+    f = value;
+    return NUMBER_FLOAT;
+  }
+
+  double value = (double)mantissa / powersOf10[decimals];
+  f = negative ? -value : value;
+  return NUMBER_FLOAT;
+}
+
+static bool parseDigits(const char *& p, const char * e, int count, int & value)
+{
+  value = 0;
+  for (int n = 0; n < count; n++, p++) {
+    if (p >= e || *p < '0' || *p > '9') return false;
+    value = value * 10 + (*p - '0');
+  }
+  return true;
+}
+
+static bool parseSeparator(const char *& p, const char * e, char separator)
+{
+  if (p >= e || *p != separator) return false;
+  p++;
+  return true;
+}
+
+// days since 1970-01-01 of a proleptic Gregorian date
+static qint64 daysFromCivil(int y, int m, int d)
+{
+  y -= m <= 2;
+  const qint64 era = (y >= 0 ? y : y - 399) / 400;
+  const int yoe = y - era * 400;
+  const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+qint64 LogData::parseTimestamp(const char * date, const char * dateEnd,
+                               const char * time, const char * timeEnd)
+{
+  int year, month, day, hour, minute, second, msecs = 0;
+
+  const char * p = date;
+  if (!parseDigits(p, dateEnd, 4, year) || !parseSeparator(p, dateEnd, '-') ||
+      !parseDigits(p, dateEnd, 2, month) || !parseSeparator(p, dateEnd, '-') ||
+      !parseDigits(p, dateEnd, 2, day) || p != dateEnd)
+    return INVALID_TIMESTAMP;
+
+  p = time;
+  if (!parseDigits(p, timeEnd, 2, hour) || !parseSeparator(p, timeEnd, ':') ||
+      !parseDigits(p, timeEnd, 2, minute) || !parseSeparator(p, timeEnd, ':') ||
+      !parseDigits(p, timeEnd, 2, second))
+    return INVALID_TIMESTAMP;
+
+  if (p < timeEnd) {
+    if (!parseSeparator(p, timeEnd, '.'))
+      return INVALID_TIMESTAMP;
+    int digits = timeEnd - p;
+    if (digits < 1 || digits > 3 || !parseDigits(p, timeEnd, digits, msecs))
+      return INVALID_TIMESTAMP;
+    for (; digits < 3; digits++) {
+      msecs *= 10;
+    }
+  }
+
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59)
+    return INVALID_TIMESTAMP;
+
+  qint64 result = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+  return result * 1000 + msecs;
+}
+
+void LogData::parseChunk(Chunk & chunk, int numFields)
+{
+  QVarLengthArray<const char *, 64> fields(numFields + 1);
+  qint64 cachedHour = INVALID_TIMESTAMP;
+  qint64 cachedOffset = 0;
+
+  chunk.lines = 0;
+  chunk.errors = 0;
+  chunk.columns.resize(numFields);
+  for (int col = 0; col < numFields; col++) {
+    chunk.columns[col].type = (col < 2 ? COLUMN_TEXT : COLUMN_INT);
+  }
+
+  const char * p = chunk.begin;
+  while (p < chunk.end) {
+    const char * eol = (const char *)memchr(p, '\n', chunk.end - p);
+    if (!eol) eol = chunk.end;
+    const char * next = (eol < chunk.end ? eol + 1 : eol);
+
+    const char * s = p;
+    const char * e = eol;
+    while (s < e && isBlank(*s)) s++;
+    while (e > s && isBlank(e[-1])) e--;
+    p = next;
+    chunk.lines++;
+
+    int count = 0;
+    fields[0] = s;
+    for (const char * c = s; c < e; c++) {
+      if (*c == ',' && ++count < numFields) {
+        fields[count] = c + 1;
+      }
+    }
+    if (++count != numFields) {
+      chunk.errors++;
+      continue;
+    }
+    fields[numFields] = e + 1;
+
+    if (chunk.timestamps.isEmpty()) {
+      int estimate = (chunk.end - s) / (e - s + 1) + 1;
+      chunk.timestamps.reserve(estimate);
+      chunk.lineOffsets.reserve(estimate);
+      chunk.lineLengths.reserve(estimate);
+      for (int col = 2; col < numFields; col++) {
+        chunk.columns[col].ints.reserve(estimate);
+      }
+    }
+
+    chunk.lineOffsets.append(chunk.offset + (s - chunk.begin));
+    chunk.lineLengths.append(e - s);
+
+    // dates are written in local time
+    qint64 timestamp = parseTimestamp(fields[0], fields[1] - 1, fields[1], fields[2] - 1);
+    if (timestamp != INVALID_TIMESTAMP) {
+      qint64 hour = timestamp / 3600000;
+      if (hour != cachedHour) {
+        QDateTime utc = QDateTime::fromMSecsSinceEpoch(hour * 3600000, Qt::UTC);
+        QDateTime local(utc.date(), utc.time(), Qt::LocalTime);
+        if (local.isValid()) {
+          cachedOffset = local.offsetFromUtc() * 1000LL;
+        }
+        cachedHour = hour;
+      }
+      timestamp -= cachedOffset;
+    }
+    chunk.timestamps.append(timestamp);
+
+    for (int col = 2; col < numFields; col++) {
+      Column & column = chunk.columns[col];
+      if (column.type == COLUMN_TEXT) {
+        continue;
+      }
+
+      qint32 i;
+      float f;
+      switch (parseNumber(fields[col], fields[col + 1] - 1, i, f)) {
+        case NUMBER_INT:
+          if (column.type == COLUMN_INT)
+            column.ints.append(i);
+          else
+            column.floats.append(i);
+          break;
+
+        case NUMBER_FLOAT:
+          if (column.type == COLUMN_INT) {
+            column.floats.reserve(column.ints.capacity());
+            for (qint32 value: column.ints) {
+              column.floats.append(value);
+            }
+            column.ints = QVector<qint32>();
+            column.type = COLUMN_FLOAT;
+          }
+          column.floats.append(f);
+          break;
+
+        default:
+          column.ints = QVector<qint32>();
+          column.floats = QVector<float>();
+          column.type = COLUMN_TEXT;
+          break;
+      }
+    }
+  }
+}
+
+LogData::LogData():
+  data(nullptr),
+  size(0),
+  linesCount(0),
+  errorsCount(0)
+{
+}
+
+LogData::~LogData()
+{
+  clear();
+}
+
+void LogData::clear()
+{
+  file.close();
+  buffer.clear();
+  data = nullptr;
+  size = 0;
+  headers.clear();
+  columns.clear();
+  timestamps.clear();
+  lineOffsets.clear();
+  lineLengths.clear();
+  linesCount = 0;
+  errorsCount = 0;
+}
+
+bool LogData::load(const QString & filename)
+{
+  clear();
+
+  file.setFileName(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  size = file.size();
+  data = (const char *)file.map(0, size);
+  if (!data) {
+    // not a mappable file, read it at once
+    buffer = file.readAll();
+    data = buffer.constData();
+    size = buffer.size();
+  }
+
+  const char * end = data + size;
+  const char * eol = (const char *)memchr(data, '\n', size);
+  if (!eol) eol = end;
+
+  QByteArray header = QByteArray::fromRawData(data, eol - data);
+  if (!header.startsWith("Date,Time")) {
+    clear();
+    return false;
+  }
+  headers = QString::fromUtf8(header).trimmed().split(',');
+  const int numFields = headers.size();
+
+  // split the body into line aligned chunks, one per thread
+  const char * body = (eol < end ? eol + 1 : eol);
+  const qint64 bodySize = end - body;
+  const int threads = std::max(1u, std::thread::hardware_concurrency());
+  const int count = qBound<qint64>(1, bodySize / LOG_CHUNK_MIN_SIZE, threads);
+
+  std::vector<Chunk> chunks(count);
+  const char * begin = body;
+  for (int i = 0; i < count; i++) {
+    const char * split = end;
+    if (i < count - 1) {
+      split = std::max(begin, body + bodySize * (i + 1) / count);
+      const char * nl = (const char *)memchr(split, '\n', end - split);
+      split = (nl ? nl + 1 : end);
+    }
+    chunks[i].begin = begin;
+    chunks[i].end = split;
+    chunks[i].offset = begin - data;
+    begin = split;
+  }
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < count; i++) {
+    workers.emplace_back(parseChunk, std::ref(chunks[i]), numFields);
+  }
+  parseChunk(chunks[0], numFields);
+  for (auto & worker: workers) {
+    worker.join();
+  }
+
+  // merge the chunks into the final columns
+  int rows = 0;
+  columns.resize(numFields);
+  for (int col = 0; col < numFields; col++) {
+    columns[col].type = (col < 2 ? COLUMN_TEXT : COLUMN_INT);
+  }
+  for (const Chunk & chunk: chunks) {
+    rows += chunk.timestamps.size();
+    linesCount += chunk.lines;
+    errorsCount += chunk.errors;
+    for (int col = 2; col < numFields; col++) {
+      ColumnType type = chunk.columns[col].type;
+      if (type == COLUMN_TEXT || (type == COLUMN_FLOAT && columns[col].type == COLUMN_INT)) {
+        columns[col].type = type;
+      }
+    }
+  }
+
+  timestamps.reserve(rows);
+  lineOffsets.reserve(rows);
+  lineLengths.reserve(rows);
+  for (int col = 2; col < numFields; col++) {
+    Column & column = columns[col];
+    if (column.type == COLUMN_INT)
+      column.ints.reserve(rows);
+    else if (column.type == COLUMN_FLOAT)
+      column.floats.reserve(rows);
+  }
+
+  for (Chunk & chunk: chunks) {
+    timestamps += chunk.timestamps;
+    lineOffsets += chunk.lineOffsets;
+    lineLengths += chunk.lineLengths;
+    chunk.timestamps = QVector<qint64>();
+    chunk.lineOffsets = QVector<qint64>();
+    chunk.lineLengths = QVector<quint32>();
+
+    for (int col = 2; col < numFields; col++) {
+      Column & column = columns[col];
+      Column & source = chunk.columns[col];
+      if (column.type == COLUMN_INT) {
+        column.ints += source.ints;
+      }
+      else if (column.type == COLUMN_FLOAT) {
+        if (source.type == COLUMN_FLOAT) {
+          column.floats += source.floats;
+        }
+        else {
+          for (qint32 value: source.ints) {
+            column.floats.append(value);
+          }
+        }
+      }
+      source.ints = QVector<qint32>();
+      source.floats = QVector<float>();
+    }
+  }
+
+  return true;
+}
+
+QDateTime LogData::dateTime(int row) const
+{
+  qint64 ts = timestamps.at(row);
+  if (ts == INVALID_TIMESTAMP)
+    return QDateTime();
+  return QDateTime::fromMSecsSinceEpoch(ts);
+}
+
+double LogData::value(int row, int col) const
+{
+  const Column & column = columns.at(col);
+  switch (column.type) {
+    case COLUMN_INT:
+      return column.ints.at(row);
+    case COLUMN_FLOAT:
+      return column.floats.at(row);
+    default:
+      return text(row, col).toDouble();
+  }
+}
+
+QString LogData::text(int row, int col) const
+{
+  const char * s = data + lineOffsets.at(row);
+  const char * e = s + lineLengths.at(row);
+
+  for (; col > 0 && s < e; s++) {
+    if (*s == ',') col--;
+  }
+
+  const char * c = (const char *)memchr(s, ',', e - s);
+  return QString::fromUtf8(s, (c ? c : e) - s);
+}
+
+QByteArray LogData::line(int row) const
+{
+  return QByteArray(data + lineOffsets.at(row), lineLengths.at(row));
+}
+
+QVector<int> LogData::sessionStarts(int maxGap) const
+{
+  QVector<int> result;
+  qint64 last = INVALID_TIMESTAMP;
+
+  for (int row = 0; row < timestamps.size(); row++) {
+    qint64 ts = timestamps.at(row);
+    if (last == INVALID_TIMESTAMP || (ts != INVALID_TIMESTAMP && (ts - last) / 1000 > maxGap)) {
+      result.append(row);
+    }
+    last = ts;
+  }
+
+  return result;
+}
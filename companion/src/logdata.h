@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <limits>
+
+// Telemetry log ("Date,Time,...") loaded into typed columns.
+//
+// The file is memory mapped and split into line-aligned chunks which are
+// parsed in parallel. Each data column ends up as int32 or float values;
+// columns holding anything else (GPS coordinates, ...) are kept as text and
+// read back from the mapped file on demand.
+class LogData
+{
+  public:
+    enum ColumnType {
+      COLUMN_TEXT,
+      COLUMN_INT,
+      COLUMN_FLOAT
+    };
+
+    static constexpr qint64 INVALID_TIMESTAMP = std::numeric_limits<qint64>::min();
+
+    LogData();
+    ~LogData();
+
+    bool load(const QString & filename);
+    void clear();
+
+    bool isEmpty() const { return timestamps.isEmpty(); }
+    int rowCount() const { return timestamps.size(); }
+    int columnCount() const { return headers.size(); }
+    const QStringList & header() const { return headers; }
+    int findColumn(const QString & name) const { return headers.indexOf(name); }
+
+    // lines read after the header, and how many of those were dropped
+    int totalLines() const { return linesCount; }
+    int invalidLines() const { return errorsCount; }
+
+    ColumnType columnType(int col) const { return columns.at(col).type; }
+
+    // milliseconds since epoch, or INVALID_TIMESTAMP
+    qint64 timestamp(int row) const { return timestamps.at(row); }
+    QDateTime dateTime(int row) const;
+
+    double value(int row, int col) const;
+    QString text(int row, int col) const;
+    QByteArray line(int row) const;
+
+    // first row of each flight session, a new session starts after
+    // a gap of more than maxGap seconds
+    QVector<int> sessionStarts(int maxGap = 60) const;
+
+    // "yyyy-MM-dd" and "HH:mm:ss[.zzz]" as milliseconds since epoch,
+    // taking the time as UTC
+    static qint64 parseTimestamp(const char * date, const char * dateEnd,
+                                 const char * time, const char * timeEnd);
+
+  protected:
+    struct Column {
+      ColumnType type;
+      QVector<qint32> ints;
+      QVector<float> floats;
+    };
+
+    struct Chunk;
+
+    QFile file;
+    QByteArray buffer;
+    const char * data;
+    qint64 size;
+
+    QStringList headers;
+    QVector<Column> columns;
+    QVector<qint64> timestamps;
+    QVector<qint64> lineOffsets;
+    QVector<quint32> lineLengths;
+    int linesCount;
+    int errorsCount;
+
+    static void parseChunk(Chunk & chunk, int numFields);
+};
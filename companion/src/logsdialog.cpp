@@ -18,6 +18,7 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <math.h>
 #include "logsdialog.h"
 #include "appdata.h"
@@ -29,18 +30,50 @@
 #include <unistd.h>
 #endif
 
+LogTableModel::LogTableModel(const LogData & logData, QObject * parent) :
+  QAbstractTableModel(parent),
+  logData(logData)
+{
+}
+
+int LogTableModel::rowCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : logData.rowCount();
+}
+
+int LogTableModel::columnCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : logData.columnCount();
+}
+
+QVariant LogTableModel::data(const QModelIndex & index, int role) const
+{
+  if (!index.isValid() || role != Qt::DisplayRole)
+    return QVariant();
+
+  return logData.text(index.row(), index.column());
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section >= logData.columnCount())
+    return QVariant();
+
+  return logData.header().at(section);
+}
+
 LogsDialog::LogsDialog(QWidget *parent) :
   QDialog(parent, Qt::WindowTitleHint | Qt::WindowSystemMenuHint),
+  logModel(new LogTableModel(logData, this)),
   ui(new Ui::LogsDialog),
   tracerMaxAlt(0),
   cursorA(0),
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
+  ui->logTable->setModel(logModel);
 
   plotLock=false;
 
@@ -116,7 +149,7 @@ LogsDialog::LogsDialog(QWidget *parent) :
   connect(ui->customPlot, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(axisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)));
   connect(ui->customPlot, SIGNAL(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*,QMouseEvent*)), this, SLOT(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*)));
   connect(ui->FieldsTW, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
-  connect(ui->logTable, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
+  connect(ui->logTable->selectionModel(), SIGNAL(selectionChanged(QItemSelection,QItemSelection)), this, SLOT(plotLogs()));
   connect(ui->Reset_PB, SIGNAL(clicked()), this, SLOT(plotLogs()));
   connect(ui->SaveSession_PB, SIGNAL(clicked()), this, SLOT(saveSession()));
 }
@@ -236,84 +269,94 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QVector<int> LogsDialog::selectedLogRows()
 {
-  QList<QStringList> result;
+  QVector<int> rows;
 
-  int n = input.count();
-  if (n == 0) {
-    return result;
+  foreach (const QItemSelectionRange & range, ui->logTable->selectionModel()->selection()) {
+    for (int row = range.top(); row <= range.bottom(); row++) {
+      rows.append(row);
+    }
   }
 
-  int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
-      gpscol=i;
-    }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  return rows;
+}
+
+QVector<int> LogsDialog::filterGePoints()
+{
+  QVector<int> result;
+
+  if (logData.isEmpty()) {
+    return result;
   }
-  if (gpscol == 0) {
+
+  int gpscol = logData.header().lastIndexOf("GPS");
+  if (gpscol <= 0) {
     QMessageBox::critical(this, tr("Error: no GPS data found"),
       tr("The column containing GPS coordinates must be named \"GPS\".\n\n\
 The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  QVector<int> selectedRows = selectedLogRows();
+  bool rangeSelected = !selectedRows.isEmpty();
+  int n = rangeSelected ? selectedRows.size() : logData.rowCount();
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
-
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+  for (int i = 0; i < n; i++) {
+    int row = rangeSelected ? selectedRows.at(i) : i;
+    GpsCoord coord = extractGpsCoordinates(logData.text(row, gpscol));
 
-      // glitch filter
-      if ( glitchFilter.isGlitch(coord) ) {
-        // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
-
-      // lat long pair filter
-      if ( !latLonFilter.isValid(coord) ) {
-        // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
+    // glitch filter
+    if ( glitchFilter.isGlitch(coord) ) {
+      // qDebug() << "filterGePoints(): GPS glitch detected at" << row << coord.latitude << coord.longitude;
+      continue;
+    }
 
-      // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+    // lat long pair filter
+    if ( !latLonFilter.isValid(coord) ) {
+      // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << row << coord.latitude << coord.longitude;
+      continue;
     }
+
+    // qDebug() << "point " << latitude << longitude;
+    result.append(row);
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << n << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
+  QVector<int> dataPoints = filterGePoints();
   int n = dataPoints.count(); // number of points to export
   if (n==0) return;
 
+  const QStringList & header = logData.header();
+
   int gpscol=0, altcol=0, speedcol=0;
   double altMultiplier = 1.0;
 
   QSet<int> nondataCols;
-  for (int i=1; i<dataPoints.at(0).count(); i++) {
+  for (int i=1; i<header.count(); i++) {
     // Long,Lat,Course,GPS Speed,GPS Alt
-    if (dataPoints.at(0).at(i) == "GPS") {
+    if (header.at(i) == "GPS") {
       gpscol=i;
     }
-    if (dataPoints.at(0).at(i).contains("GAlt")) {
+    if (header.at(i).contains("GAlt")) {
       altcol = i;
       nondataCols << i;
-      if (dataPoints.at(0).at(i).contains("(ft)")) {
+      if (header.at(i).contains("(ft)")) {
         altMultiplier = 0.3048;    // feet to meters
       }
     }
-    if (dataPoints.at(0).at(i).contains("GSpd")) {
+    if (header.at(i).contains("GSpd")) {
       speedcol = i;
       nondataCols << i;
     }
@@ -353,9 +396,9 @@ void LogsDialog::exportToGoogleEarth()
   outputStream << "\t\t\t<gx:SimpleArrayField name=\"GPSSpeed\" type=\"float\">\n\t\t\t\t<displayName>GPS Speed</displayName>\n\t\t\t</gx:SimpleArrayField>\n";
 
   // declare additional fields
-  for (int i=0; i<dataPoints.at(0).count()-2; i++) {
+  for (int i=0; i<header.count()-2; i++) {
     if (ui->FieldsTW->item(i, 0) && ui->FieldsTW->item(i, 0)->isSelected() && !nondataCols.contains(i+2)) {
-      QString origName = dataPoints.at(0).at(i+2);
+      QString origName = header.at(i+2);
       QString safeName = origName;
       safeName.replace(" ","_");
       outputStream << "\t\t\t<gx:SimpleArrayField name=\""<< safeName <<"\" ";
@@ -378,17 +421,17 @@ void LogsDialog::exportToGoogleEarth()
   outputStream << "\n\t\t\t\t\t<altitudeMode>absolute</altitudeMode>\n";
 
   // time data points
-  for (int i=1; i<n; i++) {
-    QString tstamp=dataPoints.at(i).at(0)+QString("T")+dataPoints.at(i).at(1)+QString("Z");
+  for (int i=0; i<n; i++) {
+    QString tstamp=logData.text(dataPoints.at(i), 0)+QString("T")+logData.text(dataPoints.at(i), 1)+QString("Z");
     outputStream << "\t\t\t\t\t<when>"<< tstamp <<"</when>\n";
   }
 
   // coordinate data points
   outputStream.setRealNumberNotation(QTextStream::FixedNotation);
   outputStream.setRealNumberPrecision(8);
-  for (int i=1; i<n; i++) {
-    GpsCoord coord = extractGpsCoordinates(dataPoints.at(i).at(gpscol));
-    int altitude = altcol ? (dataPoints.at(i).at(altcol).toFloat() * altMultiplier) : 0;
+  for (int i=0; i<n; i++) {
+    GpsCoord coord = extractGpsCoordinates(logData.text(dataPoints.at(i), gpscol));
+    int altitude = altcol ? (logData.value(dataPoints.at(i), altcol) * altMultiplier) : 0;
     outputStream << "\t\t\t\t\t<gx:coord>" << coord.longitude << " " << coord.latitude << " " << altitude << " </gx:coord>\n" ;
   }
 
@@ -398,20 +441,20 @@ void LogsDialog::exportToGoogleEarth()
   if (speedcol) {
     // gps speed data points
     outputStream << "\t\t\t\t\t\t\t<gx:SimpleArrayData name=\"GPSSpeed\">\n";
-    for (int i=1; i<n; i++) {
-      outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< dataPoints.at(i).at(speedcol) <<"</gx:value>\n";
+    for (int i=0; i<n; i++) {
+      outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< logData.text(dataPoints.at(i), speedcol) <<"</gx:value>\n";
     }
     outputStream << "\t\t\t\t\t\t\t</gx:SimpleArrayData>\n";
   }
 
   // add values for additional fields
-  for (int i=0; i<dataPoints.at(0).count()-2; i++) {
+  for (int i=0; i<header.count()-2; i++) {
     if (ui->FieldsTW->item(i, 0) && ui->FieldsTW->item(i, 0)->isSelected() && !nondataCols.contains(i+2)) {
-      QString safeName = dataPoints.at(0).at(i+2);;
+      QString safeName = header.at(i+2);
       safeName.replace(" ","_");
       outputStream << "\t\t\t\t\t\t\t<gx:SimpleArrayData name=\""<< safeName <<"\">\n";
-      for (int j=1; j<n; j++) {
-        outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< dataPoints.at(j).at(i+2) <<"</gx:value>\n";
+      for (int j=0; j<n; j++) {
+        outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< logData.text(dataPoints.at(j), i+2) <<"</gx:value>\n";
       }
       outputStream << "\t\t\t\t\t\t\t</gx:SimpleArrayData>\n";
     }
@@ -572,39 +615,20 @@ void LogsDialog::on_fileOpen_BT_clicked()
     g.logDir(fileName);
     ui->FileName_LE->setText(fileName);
     if (cvsFileParse()) {
+      const QStringList & header = logData.header();
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
+      ui->FieldsTW->setRowCount(header.count()-2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
       ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
+      for (int i=2; i<header.count(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(header.at(i));
         ui->FieldsTW->setItem(i-2, 0, item);
       }
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
-
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-      QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        sizes.append(ui->logTable->columnWidth(i));
-      }
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        ui->logTable->setColumnWidth(i, sizes.at(i));
-      }
+      ui->logTable->resizeColumnsToContents();
     }
   }
 }
@@ -614,92 +638,48 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    int start = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int end = logData.rowCount();
+    if (index < ui->sessions_CB->count() - 1) {
+      end = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     }
-    // save the filtered records to a new file
+    // save the session records to a new file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
-      QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      // add CSV headers from first row of source file
+      data.write(logData.header().join(",").toUtf8() + '\n');
+      for(int i = start; i < end; i++){
+        data.write(logData.line(i) + '\n');
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
 bool LogsDialog::cvsFileParse()
 {
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
+  logFilename.clear();
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  logModel->beginUpdate();
+  bool loaded = logData.load(ui->FileName_LE->text());
+  logModel->endUpdate();
+
+  if (!loaded) {
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
-
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
-
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
 
-    logFilename = QFileInfo(file.fileName()).baseName();
-  }
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
 
-  file.close();
-  if (errors > 1) {
-    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
+  if (logData.invalidLines() > 1) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(logData.invalidLines()).arg(logData.totalLines()));
   }
 
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
+  if (logData.isEmpty()) {
+    logModel->beginUpdate();
+    logData.clear();
+    logModel->endUpdate();
     return false;
   }
 
@@ -715,12 +695,9 @@ struct FlightSession {
   QDateTime end;
 };
 
-QDateTime LogsDialog::getRecordTimeStamp(int index)
+QDateTime LogsDialog::getRecordTimeStamp(int row)
 {
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
+  return logData.dateTime(row);
 }
 
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
@@ -740,35 +717,26 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  int n = logData.rowCount();
   // qDebug() << "records" << n;
 
   // find session breaks
-  QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
-    }
-    lastvalue = tmp;
-  }
-  sessions.push_back(n-1);
+  QVector<int> sessions = logData.sessionStarts();
+  sessions.push_back(n);
 
   //now construct a list of sessions with their times
   //total time
   int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(0), getRecordTimeStamp(n-1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1));
+      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i)-1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i-1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -788,13 +756,13 @@ void LogsDialog::on_sessions_CB_currentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logData.rowCount();
     }
 
     QModelIndex topLeft = ui->logTable->model()->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
     QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+      bottom - 1, logData.columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -813,32 +781,41 @@ void LogsDialog::plotLogs()
 {
   if (plotLock) return;
 
-  if (!ui->FieldsTW->selectedItems().length()) {
+  if (!ui->FieldsTW->selectedItems().length() || logData.isEmpty()) {
     removeAllGraphs();
     return;
   }
 
   plotsCollection plots;
 
-  QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
-  QVarLengthArray<int> selectedRows;
-
-  if (rowCount) {
-    hasLogSelection = true;
-    foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
-    }
-    std::sort(selectedRows.begin(), selectedRows.end());
-  } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
-  }
+  QVector<int> selectedRows = selectedLogRows();
+  bool hasLogSelection = !selectedRows.isEmpty();
+  int rowCount = hasLogSelection ? selectedRows.size() : logData.rowCount();
 
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
 
+  // the time axis is shared by all plots
+  QVector<int> plotRows;
+  QVector<double> plotTimes;
+  plotRows.reserve(rowCount);
+  plotTimes.reserve(rowCount);
+
+  for (int i = 0; i < rowCount; i++) {
+    int row = hasLogSelection ? selectedRows.at(i) : i;
+    qint64 timestamp = logData.timestamp(row);
+    if (timestamp == LogData::INVALID_TIMESTAMP) {
+      continue;
+    }
+
+    double time = timestamp / 1000.0;
+    plotRows.append(row);
+    plotTimes.append(time);
+
+    if (plots.min_x > time) plots.min_x = time;
+    if (plots.max_x < time) plots.max_x = time;
+  }
+
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
     int plotColumn = plot->row() + 2; // Date and Time first
@@ -847,41 +824,15 @@ void LogsDialog::plotLogs()
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
+    plotCoords.x = plotTimes;
+    plotCoords.y.reserve(plotRows.size());
 
-    for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
-
-      y = logValue->text().toDouble();
+    foreach (int row, plotRows) {
+      double y = logData.value(row, plotColumn);
       plotCoords.y.push_back(y);
 
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
-
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
-      }
-      plotCoords.x.push_back(time);
-
-      if (plots.min_x > time) plots.min_x = time;
-      if (plots.max_x < time) plots.max_x = time;
     }
 
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
@@ -23,7 +23,9 @@
 
 #include <QtCore>
 #include <QDialog>
+#include <QAbstractTableModel>
 #include "qcustomplot.h"
+#include "logdata.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -32,6 +34,26 @@ namespace Ui {
   class LogsDialog;
 }
 
+class LogTableModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  public:
+    explicit LogTableModel(const LogData & logData, QObject * parent = nullptr);
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // to be called around any change of the underlying log data
+    void beginUpdate() { beginResetModel(); }
+    void endUpdate() { endResetModel(); }
+
+  private:
+    const LogData & logData;
+};
+
 class LogsDialog : public QDialog
 {
   Q_OBJECT
@@ -84,7 +106,8 @@ private slots:
   void yAxisChangeRanges(QCPRange range);
 
 private:
-  QList<QStringList> csvlog;
+  LogData logData;
+  LogTableModel *logModel;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -103,9 +126,10 @@ private:
   QCPItemStraightLine * cursorLine;
 
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QVector<int> selectedLogRows();
+  QVector<int> filterGePoints();
   void exportToGoogleEarth();
-  QDateTime getRecordTimeStamp(int index);
+  QDateTime getRecordTimeStamp(int row);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
 
@@ -194,7 +194,7 @@ void LogicalSwitchesPanel::onFunctionChanged()
     updateLine(i);
 
     if (oldFunc == LS_FN_OFF || newFunc == LS_FN_OFF)
-      updateItemModels();
+      updateItemModels(i, 1);
 
     emit modified();
   }
@@ -494,7 +494,7 @@ void LogicalSwitchesPanel::cmPaste()
   if (hasClipboardData(&data)) {
     memcpy(&model->logicalSw[selectedIndex], data.constData(), sizeof(LogicalSwitchData));
     updateLine(selectedIndex);
-    updateItemModels();
+    updateItemModels(selectedIndex, 1);
     emit modified();
   }
 }
@@ -509,7 +509,7 @@ void LogicalSwitchesPanel::cmDelete()
 
   model->updateAllReferences(ModelData::REF_UPD_TYPE_LOGICAL_SWITCH, ModelData::REF_UPD_ACT_SHIFT, selectedIndex, 0, -1);
   update();
-  updateItemModels();
+  updateItemModels(selectedIndex);
   emit modified();
 }
 
@@ -599,7 +599,7 @@ void LogicalSwitchesPanel::cmClear(bool prompt)
   model->logicalSw[selectedIndex].clear();
   model->updateAllReferences(ModelData::REF_UPD_TYPE_LOGICAL_SWITCH, ModelData::REF_UPD_ACT_CLEAR, selectedIndex);
   updateLine(selectedIndex);
-  updateItemModels();
+  updateItemModels(selectedIndex, 1);
   emit modified();
 }
 
@@ -623,7 +623,7 @@ void LogicalSwitchesPanel::cmInsert()
   model->logicalSw[selectedIndex].clear();
   model->updateAllReferences(ModelData::REF_UPD_TYPE_LOGICAL_SWITCH, ModelData::REF_UPD_ACT_SHIFT, selectedIndex, 0, 1);
   update();
-  updateItemModels();
+  updateItemModels(selectedIndex);
   emit modified();
 }
 
@@ -638,15 +638,15 @@ void LogicalSwitchesPanel::swapData(int idx1, int idx2)
     model->updateAllReferences(ModelData::REF_UPD_TYPE_LOGICAL_SWITCH, ModelData::REF_UPD_ACT_SWAP, idx1, idx2);
     updateLine(idx1);
     updateLine(idx2);
-    updateItemModels();
+    updateItemModels(qMin(idx1, idx2), abs(idx1 - idx2) + 1);
     emit modified();
   }
 }
 
-void LogicalSwitchesPanel::updateItemModels()
+void LogicalSwitchesPanel::updateItemModels(const int first, const int count)
 {
   lock = true;
-  sharedItemModels->update(AbstractItemModel::IMUE_LogicalSwitches);
+  sharedItemModels->update(AbstractItemModel::IMUE_LogicalSwitches, first, count);
 }
 
 void LogicalSwitchesPanel::connectItemModelEvents(const FilteredItemModel * itemModel)
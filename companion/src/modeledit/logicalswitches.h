@@ -88,7 +88,7 @@ class LogicalSwitchesPanel : public ModelPanel
     bool moveDownAllowed() const;
     bool moveUpAllowed() const;
     int modelsUpdateCnt;
-    void updateItemModels();
+    void updateItemModels(const int first = 0, const int count = -1);
     void connectItemModelEvents(const FilteredItemModel * itemModel);
 };
 
@@ -221,7 +221,7 @@ void TelemetrySensorPanel::update()
 
 void TelemetrySensorPanel::on_nameDataChanged()
 {
-  emit dataModified();
+  emit dataModified(sensorIndex);
 }
 
 void TelemetrySensorPanel::on_formulaDataChanged()
@@ -313,7 +313,7 @@ void TelemetrySensorPanel::cmPaste()
   QByteArray data;
   if (hasClipboardData(&data)) {
     memcpy(&sensor, data.constData(), sizeof(SensorData));
-    emit dataModified();
+    emit dataModified(sensorIndex);
   }
 }
 
@@ -326,7 +326,7 @@ void TelemetrySensorPanel::cmClear(bool prompt)
 
   sensor.clear();
   model->updateAllReferences(ModelData::REF_UPD_TYPE_SENSOR, ModelData::REF_UPD_ACT_CLEAR, selectedIndex);
-  emit dataModified();
+  emit dataModified(sensorIndex);
 }
 
 void TelemetrySensorPanel::cmClearAll()
@@ -445,7 +445,7 @@ TelemetryPanel::TelemetryPanel(QWidget *parent, ModelData & model, GeneralSettin
                                                             firmware, lock, panelFilteredItemModels);
     ui->sensorsLayout->addWidget(panel);
     sensorPanels[i] = panel;
-    connect(panel, SIGNAL(dataModified()), this, SLOT(on_dataModifiedSensor()));
+    connect(panel, SIGNAL(dataModified(int)), this, SLOT(on_dataModifiedSensor(int)));
     connect(panel, SIGNAL(modified()), this, SLOT(onModified()));
     connect(panel, SIGNAL(clearAllSensors()), this, SLOT(on_clearAllSensors()));
     connect(panel, SIGNAL(insertSensor(int)), this, SLOT(on_insertSensor(int)));
@@ -690,7 +690,7 @@ void TelemetryPanel::on_clearAllSensors()
     model->updateAllReferences(ModelData::REF_UPD_TYPE_SENSOR, ModelData::REF_UPD_ACT_CLEAR, i);
   }
 
-  on_dataModifiedSensor();
+  on_dataModifiedSensor(0, -1);
 }
 
 void TelemetryPanel::on_insertSensor(int selectedIndex)
@@ -698,7 +698,7 @@ void TelemetryPanel::on_insertSensor(int selectedIndex)
   memmove(&model->sensorData[selectedIndex + 1], &model->sensorData[selectedIndex], (CPN_MAX_SENSORS - (selectedIndex + 1)) * sizeof(SensorData));
   model->sensorData[selectedIndex].clear();
   model->updateAllReferences(ModelData::REF_UPD_TYPE_SENSOR, ModelData::REF_UPD_ACT_SHIFT, selectedIndex, 0, 1);
-  on_dataModifiedSensor();
+  on_dataModifiedSensor(selectedIndex, -1);
 }
 
 void TelemetryPanel::on_deleteSensor(int selectedIndex)
@@ -709,7 +709,7 @@ void TelemetryPanel::on_deleteSensor(int selectedIndex)
   memmove(&model->sensorData[selectedIndex], &model->sensorData[selectedIndex + 1], (CPN_MAX_SENSORS - (selectedIndex + 1)) * sizeof(SensorData));
   model->sensorData[CPN_MAX_SENSORS - 1].clear();
   model->updateAllReferences(ModelData::REF_UPD_TYPE_SENSOR, ModelData::REF_UPD_ACT_SHIFT, selectedIndex, 0, -1);
-  on_dataModifiedSensor();
+  on_dataModifiedSensor(selectedIndex, -1);
 }
 
 void TelemetryPanel::on_moveUpSensor(int selectedIndex)
@@ -731,13 +731,13 @@ void TelemetryPanel::swapData(int idx1, int idx2)
     memcpy(sd2, sd1, sizeof(SensorData));
     memcpy(sd1, &sdtmp, sizeof(SensorData));
     model->updateAllReferences(ModelData::REF_UPD_TYPE_SENSOR, ModelData::REF_UPD_ACT_SWAP, idx1, idx2);
-    on_dataModifiedSensor();
+    on_dataModifiedSensor(qMin(idx1, idx2), abs(idx1 - idx2) + 1);
   }
 }
 
-void TelemetryPanel::on_dataModifiedSensor()
+void TelemetryPanel::on_dataModifiedSensor(const int first, const int count)
 {
-  sharedItemModels->update(AbstractItemModel::IMUE_TeleSensors);
+  sharedItemModels->update(AbstractItemModel::IMUE_TeleSensors, first, count);
   emit modified();
 }
 
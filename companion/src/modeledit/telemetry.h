@@ -46,7 +46,7 @@ class TelemetrySensorPanel: public ModelPanel
     void update();
 
   signals:
-    void dataModified();
+    void dataModified(int index);
     void clearAllSensors();
     void insertSensor(int index);
     void deleteSensor(int index);
@@ -120,7 +120,7 @@ class TelemetryPanel : public ModelPanel
     void on_deleteSensor(int index);
     void on_moveUpSensor(int index);
     void on_moveDownSensor(int index);
-    void on_dataModifiedSensor();
+    void on_dataModifiedSensor(const int first, const int count = 1);
     void onItemModelAboutToBeUpdated();
     void onItemModelUpdateComplete();
 
@@ -22,18 +22,31 @@
 #include "helpers_html.h"
 #include "multimodelprinter.h"
 #include "appdata.h"
+#include <QCryptographicHash>
+#include <QStringBuilder>
 #include <algorithm>
 
+#define MULTICOLUMNS_RESERVE          4096    // characters per column
+#define MULTICOLUMNS_CELLS_RESERVE    64
+#define SECTION_CACHE_SIZE            (4 * 1024 * 1024)   // characters
+
 MultiModelPrinter::MultiColumns::MultiColumns(int count):
-  count(count),
-  compareColumns(NULL)
+  count(count)
 {
   columns = new QString[count];
+  cells = new QVector<QPair<int, int> >[count];
+  cellStart = new int[count];
+  for (int i=0; i<count; i++) {
+    columns[i].reserve(MULTICOLUMNS_RESERVE);
+    cells[i].reserve(MULTICOLUMNS_CELLS_RESERVE);
+  }
 }
 
 MultiModelPrinter::MultiColumns::~MultiColumns()
 {
   delete[] columns;
+  delete[] cells;
+  delete[] cellStart;
 }
 
 void MultiModelPrinter::MultiColumns::append(const QString & str)
@@ -45,37 +58,40 @@ void MultiModelPrinter::MultiColumns::append(const QString & str)
 
 void MultiModelPrinter::MultiColumns::appendTitle(const QString & name)
 {
-  append("<b>" + name + "</b>&nbsp;");
+  append("<b>" % name % "</b>&nbsp;");
 }
 
 void MultiModelPrinter::MultiColumns::append(int idx, const QString & str)
 {
-  if (compareColumns)
-    compareColumns[idx].append(str);
-  else
-    columns[idx].append(str);
+  columns[idx].append(str);
 }
 
+// The compared cells are only recorded here, the diff highlights are added by print()
 void MultiModelPrinter::MultiColumns::beginCompare()
 {
-  compareColumns = new QString[count];
+  for (int i=0; i<count; i++) {
+    cellStart[i] = columns[i].size();
+  }
 }
 
 void MultiModelPrinter::MultiColumns::endCompare()
 {
   for (int i=0; i<count; i++) {
-    QString style = "";
-    if (i==0 && count>1 && compareColumns[0]!=compareColumns[1])
-      style = "mpc-diff1";
-    else if (i>0 && compareColumns[i]!=compareColumns[0])
-      style = "mpc-diff2";
-    if (style!="")
-      columns[i].append(QString("<span class='%1'>%2</span>").arg(style).arg(compareColumns[i]));
-    else
-      columns[i].append(compareColumns[i]);
+    cells[i].append(qMakePair(cellStart[i], columns[i].size()));
+  }
+}
+
+// One hash of the text printed for each model
+QByteArray MultiModelPrinter::MultiColumns::digest() const
+{
+  QByteArray result;
+  for (int i=0; i<count; i++) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(reinterpret_cast<const char *>(columns[i].constData()), columns[i].size() * sizeof(QChar));
+    hash.addData(reinterpret_cast<const char *>(cells[i].constData()), cells[i].size() * sizeof(QPair<int, int>));
+    result.append(hash.result());
   }
-  delete[] compareColumns;
-  compareColumns = NULL;
+  return result;
 }
 
 template <class T>
@@ -86,9 +102,47 @@ void MultiModelPrinter::MultiColumns::append(int idx, T val)
 
 QString MultiModelPrinter::MultiColumns::print()
 {
-  QString result = "<tr>";
+  // the diff of the section first: a cell of the first column is highlighted when it
+  // differs from the second column, a cell of the other columns when it differs from the first
+  const int cellCount = cells[0].size();
+  QVector<QLatin1String> styles(count * cellCount, QLatin1String(""));
+  int highlighted = 0;
+  for (int c=0; c<cellCount; c++) {
+    for (int i=0; i<count; i++) {
+      const int ref = (i == 0 ? 1 : 0);
+      if (ref >= count)
+        continue;
+      const QPair<int, int> & cell = cells[i][c];
+      const QPair<int, int> & refCell = cells[ref][c];
+      if (columns[i].midRef(cell.first, cell.second - cell.first) != columns[ref].midRef(refCell.first, refCell.second - refCell.first)) {
+        styles[i * cellCount + c] = QLatin1String(i == 0 ? "mpc-diff1" : "mpc-diff2");
+        highlighted++;
+      }
+    }
+  }
+
+  const QString width = QString::number(100.0/count);
+  int size = highlighted * 32;
   for (int i=0; i<count; i++) {
-    result.append(QString("<td width='%1%'>%2</td>").arg(100.0/count).arg(columns[i]));
+    size += columns[i].size() + width.size() + 20;
+  }
+
+  QString result;
+  result.reserve(size + 9);
+  result.append("<tr>");
+  for (int i=0; i<count; i++) {
+    result += QLatin1String("<td width='") % width % QLatin1String("%'>");
+    int pos = 0;
+    for (int c=0; c<cellCount; c++) {
+      const QLatin1String & style = styles[i * cellCount + c];
+      if (!style.size())
+        continue;
+      const QPair<int, int> & cell = cells[i][c];
+      result += columns[i].midRef(pos, cell.first - pos) % QLatin1String("<span class='") % style % QLatin1String("'>") %
+                columns[i].midRef(cell.first, cell.second - cell.first) % QLatin1String("</span>");
+      pos = cell.second;
+    }
+    result += columns[i].midRef(pos) % QLatin1String("</td>");
   }
   result.append("</tr>");
   return result;
@@ -229,7 +283,10 @@ QString MultiModelPrinter::printTitle(const QString & label)
 }
 
 MultiModelPrinter::MultiModelPrinter(Firmware * firmware):
-  firmware(firmware)
+  firmware(firmware),
+  sectionCache(SECTION_CACHE_SIZE),
+  lastPrintSize(0),
+  lastPrintCacheHits(0)
 {
 }
 
@@ -248,6 +305,7 @@ void MultiModelPrinter::setModel(int idx, const ModelData * model, const General
 
   QPair<const ModelData *, ModelPrinter *> pair(model, new ModelPrinter(firmware, *generalSettings, *model));
   modelPrinterMap.insert(idx, pair);  // QMap.insert will replace any existing key
+  generalSettingsMap.insert(idx, generalSettings);
 }
 
 void MultiModelPrinter::setModel(int idx, const ModelData * model)
@@ -262,15 +320,36 @@ void MultiModelPrinter::clearModels()
       delete modelPrinterMap.value(i).second;
   }
   modelPrinterMap.clear();
+  generalSettingsMap.clear();
+}
+
+// A section is printed for each model first, its html with the diff highlights is then reused as long as
+// the text printed for every model is the same: only the sections of a changed model are diffed again
+QString MultiModelPrinter::printColumns(MultiColumns & columns)
+{
+  const QByteArray key = columns.digest();
+  const QString * cached = sectionCache.object(key);
+  if (cached) {
+    lastPrintCacheHits++;
+    return *cached;
+  }
+
+  const QString str = columns.print();
+  sectionCache.insert(key, new QString(str), str.size());
+  return str;
 }
 
 QString MultiModelPrinter::print(QTextDocument * document)
 {
   if (document) document->clear();
   Stylesheet css(MODEL_PRINT_CSS);
-  if (css.load(Stylesheet::StyleType::STYLE_TYPE_EFFECTIVE))
+  if (document && css.load(Stylesheet::StyleType::STYLE_TYPE_EFFECTIVE))
     document->setDefaultStyleSheet(css.text());
-  QString str = "<table cellspacing='0' cellpadding='3' width='100%'>";   // attributes not settable via QT stylesheet
+
+  lastPrintCacheHits = 0;
+  QString str;
+  str.reserve(lastPrintSize);
+  str.append("<table cellspacing='0' cellpadding='3' width='100%'>");   // attributes not settable via QT stylesheet
   str.append(printSetup());
   if (firmware->getCapability(HasDisplayText))
     str.append(printChecklist());
@@ -280,7 +359,7 @@ QString MultiModelPrinter::print(QTextDocument * document)
   if (Boards::getCapability(firmware->getBoard(), Board::FunctionSwitches)) {
     str.append(printFunctionSwitches());
   }
-  
+
   str.append(printModules());
   if (firmware->getCapability(Heli))
     str.append(printHeliSetup());
@@ -304,6 +383,7 @@ QString MultiModelPrinter::print(QTextDocument * document)
     }
   }
   str.append("</table>");
+  lastPrintSize = str.size();
   return str;
 }
 
@@ -329,7 +409,7 @@ QString MultiModelPrinter::printSetup()
   }
   ROWLABELCOMPARECELL(tr("Other"), 0, modelPrinter->printSettingsOther(), 0);
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -356,7 +436,7 @@ QString MultiModelPrinter::printTimers()
     columns.appendRowEnd();
   }
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -378,7 +458,7 @@ QString MultiModelPrinter::printModules()
     COMPARECELL(modelPrinter->printModule(-1));
     columns.appendRowEnd();
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -418,7 +498,7 @@ QString MultiModelPrinter::printHeliSetup()
   columns.appendRowEnd();
 
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -450,7 +530,7 @@ QString MultiModelPrinter::printFlightModes()
     }
 
     columns.appendTableEnd();
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
 
   // GVars and Rotary Encoders
@@ -520,7 +600,7 @@ QString MultiModelPrinter::printFlightModes()
       columns.appendRowEnd();
     }
     columns.appendTableEnd();
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
 
   return str;
@@ -573,7 +653,7 @@ QString MultiModelPrinter::printOutputs()
     columns.appendRowEnd();
   }
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -594,7 +674,7 @@ QString MultiModelPrinter::printGvars()
   }
   columns.appendRowEnd();
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -624,7 +704,7 @@ QString MultiModelPrinter::printInputs()
     }
   }
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -654,7 +734,7 @@ QString MultiModelPrinter::printMixers()
     }
   }
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -691,7 +771,7 @@ QString MultiModelPrinter::printCurves(QTextDocument * document)
   columns.appendTableEnd();
   if (count > 0) {
     str.append(printTitle(tr("Curves")));
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
   return str;
 }
@@ -720,7 +800,7 @@ QString MultiModelPrinter::printLogicalSwitches()
   columns.appendTableEnd();
   if (count > 0) {
     str.append(printTitle(tr("Logical Switches")));
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
   return str;
 }
@@ -749,7 +829,7 @@ QString MultiModelPrinter::printSpecialFunctions()
   columns.appendTableEnd();
   if (count > 0) {
     str.append(printTitle(tr("Special Functions")));
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
   return str;
 }
@@ -818,7 +898,7 @@ QString MultiModelPrinter::printTelemetry()
 
   // Various
   columns.appendTableEnd();
-  str.append(columns.print());
+  str.append(printColumns(columns));
   return str;
 }
 
@@ -851,7 +931,7 @@ QString MultiModelPrinter::printSensors()
   columns.appendTableEnd();
   if (count > 0) {
     str.append(printTitle(tr("Telemetry Sensors")));
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
   return str;
 }
@@ -883,7 +963,7 @@ QString MultiModelPrinter::printTelemetryScreens()
   columns.appendTableEnd();
   if (count > 0) {
     str.append(printTitle(tr("Telemetry Screens")));
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
   return str;
 }
@@ -918,7 +998,7 @@ QString MultiModelPrinter::printGlobalFunctions()
     columns.appendTableEnd();
     if (count > 0) {
       str.append(printTitle(tr("Global Functions")));
-      str.append(columns.print());
+      str.append(printColumns(columns));
     }
   }
   return str;
@@ -939,7 +1019,7 @@ QString MultiModelPrinter::printChecklist()
     columns.appendSectionTableStart();
     ROWLABELCOMPARECELL(tr("Checklist"), 20, modelPrinter->printChecklist(), 80);
     columns.appendTableEnd();
-    str.append(columns.print());
+    str.append(printColumns(columns));
   }
   return str;
 }
@@ -997,6 +1077,6 @@ QString MultiModelPrinter::printChecklist()
    columns.appendRowEnd();
 
    columns.appendTableEnd();
-   str.append(columns.print());
+   str.append(printColumns(columns));
    return str;
  }
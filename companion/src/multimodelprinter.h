@@ -23,6 +23,7 @@
 
 #include <QObject>
 #include <QTextDocument>
+#include <QCache>
 #include "eeprominterface.h"
 #include "modelprinter.h"
 
@@ -38,6 +39,8 @@ class MultiModelPrinter: public QObject
     void setModel(int idx, const ModelData * model);
     void clearModels();
     QString print(QTextDocument * document);
+    // number of section tables of the last print() taken from the cache
+    int cacheHits() const { return lastPrintCacheHits; }
 
   protected:
     class MultiColumns {
@@ -45,6 +48,7 @@ class MultiModelPrinter: public QObject
         MultiColumns(int count);
         ~MultiColumns();
         bool isEmpty();
+        QByteArray digest() const;
         QString print();
         void append(const QString & str);
         void appendTitle(const QString & name);
@@ -69,13 +73,20 @@ class MultiModelPrinter: public QObject
 
       private:
         int count;
-        QString * columns;
-        QString * compareColumns;
+        QString * columns;                  // one per model, without the diff highlights
+        QVector<QPair<int, int> > * cells;  // the compared cells of each column, start and end
+        int * cellStart;
     };
 
     Firmware * firmware;
     GeneralSettings defaultSettings;
     QMap<int, QPair<const ModelData *, ModelPrinter *> > modelPrinterMap;
+    QMap<int, const GeneralSettings *> generalSettingsMap;
+    QCache<QByteArray, QString> sectionCache;   // html of the sections, keyed by the text printed for each model
+    int lastPrintSize;
+    int lastPrintCacheHits;
+
+    QString printColumns(MultiColumns & columns);
 
     QString printTitle(const QString & label);
     QString printSetup();
@@ -22,10 +22,25 @@
 
 #include <QApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QElapsedTimer>
+#include <QLocale>
 #include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
 
 #define SYNC_MAX_ERRORS       50  // give up after this many errors per destination
+#define SYNC_COPY_THREADS     4   // maximum number of concurrent file copies
+#define SYNC_COPY_QUEUE       (SYNC_COPY_THREADS * 4)
+#define SYNC_HASH_CHUNK       (64 * 1024)
+#define SYNC_HASH_ALGORITHM   QCryptographicHash::Md5
+
+#define MANIFEST_FILENAME     "syncmanifest.dat"
+#define MANIFEST_MAGIC        0x45534d46  // "ESMF"
+#define MANIFEST_VERSION      1
+#define MANIFEST_MTIME_SLACK  2000        // [ms] FAT time stamps have a 2s resolution
 
 // a flood of log messages can make the UI unresponsive so we'll introduce a dynamic sleep period based on log frequency (values in [us])
 #define PAUSE_FACTOR          60UL
@@ -52,6 +67,151 @@
   #define FILTER_RE_SYNTX     QRegExp::WildcardUnix
 #endif
 
+SyncManifest::SyncManifest(const QString & filename) :
+  m_filename(filename.isEmpty() ? defaultFilename() : filename),
+  m_dirty(false)
+{
+}
+
+QString SyncManifest::defaultFilename()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) % "/" % MANIFEST_FILENAME;
+}
+
+bool SyncManifest::load()
+{
+  m_entries.clear();
+  m_dirty = false;
+
+  QFile file(m_filename);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream stream(&file);
+  quint32 magic, version, count;
+  stream >> magic >> version >> count;
+  if (stream.status() != QDataStream::Ok || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION)
+    return false;
+
+  m_entries.reserve(count);
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString path;
+    Entry entry;
+    stream >> path >> entry.size >> entry.modified >> entry.checked >> entry.hash;
+    m_entries.insert(path, entry);
+  }
+
+  if (stream.status() != QDataStream::Ok) {
+    qDebug() << "Discarding corrupted sync manifest" << m_filename;
+    m_entries.clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool SyncManifest::save(const QStringList & roots)
+{
+  // forget files which were deleted from the synchronized folders
+  for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+    bool prune = false;
+    for (const QString & root : roots) {
+      if (it.key().startsWith(root) && !QFileInfo::exists(it.key())) {
+        prune = true;
+        break;
+      }
+    }
+    if (prune) {
+      it = m_entries.erase(it);
+      m_dirty = true;
+    }
+    else {
+      ++it;
+    }
+  }
+
+  if (!m_dirty)
+    return true;
+
+  QDir().mkpath(QFileInfo(m_filename).absolutePath());
+  QSaveFile file(m_filename);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+
+  QDataStream stream(&file);
+  stream << quint32(MANIFEST_MAGIC) << quint32(MANIFEST_VERSION) << quint32(m_entries.count());
+  for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+    stream << it.key() << it->size << it->modified << it->checked << it->hash;
+  }
+
+  if (!file.commit())
+    return false;
+
+  m_dirty = false;
+  return true;
+}
+
+QByteArray SyncManifest::hash(const QFileInfo & fileInfo) const
+{
+  auto it = m_entries.constFind(fileInfo.absoluteFilePath());
+  if (it == m_entries.constEnd())
+    return QByteArray();
+
+  // a file modified right before it was hashed could have changed again without
+  // its time stamp changing, don't trust these
+  const qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+  if (it->size != fileInfo.size() || it->modified != modified || it->checked - modified < MANIFEST_MTIME_SLACK)
+    return QByteArray();
+
+  return it->hash;
+}
+
+void SyncManifest::insert(const QFileInfo & fileInfo, const QByteArray & hash)
+{
+  Entry & entry = m_entries[fileInfo.absoluteFilePath()];
+  entry.size = fileInfo.size();
+  entry.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+  entry.checked = QDateTime::currentMSecsSinceEpoch();
+  entry.hash = hash;
+  m_dirty = true;
+}
+
+void SyncManifest::remove(const QString & path)
+{
+  if (m_entries.remove(path))
+    m_dirty = true;
+}
+
+class SyncCopyTask : public QRunnable
+{
+  public:
+    SyncCopyTask(SyncProcess * process, const SyncProcess::CopyResult & request) :
+      process(process),
+      result(request)
+    {
+    }
+
+    void run() override
+    {
+      if (!process->isStopRequsted()) {
+        QFile destinationFile(result.destPath);
+        QFile sourceFile(result.srcPath);
+        if (result.existed && !destinationFile.remove())
+          result.error = QCoreApplication::translate("SyncProcess", "Could not delete destination file '%1': %2").arg(result.destPath, destinationFile.errorString());
+        else if (!sourceFile.copy(result.destPath))
+          result.error = QCoreApplication::translate("SyncProcess", "Copy failed: '%1' to '%2': %3").arg(result.srcPath, result.destPath, sourceFile.errorString());
+      }
+      else {
+        result.error = QCoreApplication::translate("SyncProcess", "Copy aborted: '%1'").arg(result.srcPath);
+      }
+      process->copyFinished(result);
+    }
+
+  protected:
+    SyncProcess * process;
+    SyncProcess::CopyResult result;
+};
+
 SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   m_options(options),
   m_pauseTime(PAUSE_MINTM),
@@ -77,6 +237,8 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   if (m_options.flags & OPT_DRY_RUN)
     testRunStr = tr("[TEST RUN] ");
 
+  m_copyPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), SYNC_COPY_THREADS));
+
   //qDebug() << m_options;
 #ifdef Q_OS_WIN
   qt_ntfs_permission_lookup++;  // global enable NTFS permissions checking
@@ -85,6 +247,7 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
 
 SyncProcess::~SyncProcess()
 {
+  m_copyPool.waitForDone();
 #ifdef Q_OS_WIN
   qt_ntfs_permission_lookup--;  // global revert NTFS permissions checking
 #endif
@@ -113,6 +276,7 @@ void SyncProcess::run()
 
   m_stat.clear();
   m_startTime = QDateTime::currentDateTime();
+  m_manifest.load();
 
   emit started();
   emit fileCountChanged(0);
@@ -171,12 +335,19 @@ void SyncProcess::run()
 
 void SyncProcess::finish()
 {
+  waitForCopies();
+  m_manifest.save(QStringList() << QDir(m_options.folderA).absolutePath() << QDir(m_options.folderB).absolutePath());
+
   const lldiv_t elapsed = lldiv(m_startTime.secsTo(QDateTime::currentDateTime()), 60);
   QString endStr = testRunStr;
   if (m_stat.index < m_stat.count)
     endStr.append(tr("Synchronization aborted at %1 of %2 files.").arg(m_stat.index).arg(m_stat.count));
   else
     endStr.append(tr("Synchronization finished with %1 files in %2m %3s.").arg(m_stat.count).arg(elapsed.quot).arg(elapsed.rem));
+  if (m_options.flags & OPT_DRY_RUN)
+    endStr.append(" " % tr("%1 would be copied.").arg(formatSize(m_stat.bytes)));
+  else
+    endStr.append(" " % tr("%1 copied.").arg(formatSize(m_stat.bytes)));
   emit statusMessage(endStr);
   emit finished();
 }
@@ -258,6 +429,7 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
       pushDirEntries(fi, it);
       if ((m_dirFilters & QDir::Dirs) || fi.isFile()) {
         updateEntry(fi.filePath(), srcDir, dstDir);
+        processCopyResults();
         if (fi.isFile())
           ++m_stat.index;
         emit statusUpdate(m_stat);
@@ -288,6 +460,9 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
     pause();
   }
 
+  waitForCopies();
+  emit statusUpdate(m_stat);
+
   QString endStr = "\n" % testRunStr;
   if (isStopRequsted())
     endStr.append(tr("Aborted synchronization of:"));
@@ -295,6 +470,7 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
     endStr.append(tr("Finished synchronizing:"));
   endStr.append(QString("\n  %1 -> %2\n  ").arg(source, destination));
   endStr.append(tr("Created: %1; Updated: %2; Skipped: %3; Errors: %4;").arg(m_stat.created-pStat.created).arg(m_stat.updated-pStat.updated).arg(m_stat.skipped-pStat.skipped).arg(m_stat.errored-pStat.errored));
+  endStr.append(" " % tr("Size: %1;").arg(formatSize(m_stat.bytes - pStat.bytes)));
   PRINT_INFO(endStr);
   PRINT_SEP();
 }
@@ -336,12 +512,10 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
   }
 
   //qDebug() << destPath;
-  QFile sourceFile(srcPath);
-  QFile destinationFile(destPath);
   const bool destExists = destInfo.exists();
   bool checkDate = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_NEWER_ALWAYS);
   bool checkContent = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_IF_DIFF);
-  bool existed = false;
+  QByteArray srcHash;
 
   if (destExists && checkDate) {
     const QDate cmprDate = QDate::currentDate();
@@ -358,55 +532,149 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
     checkDate = false;
   }
 
-  if (destExists && checkContent) {
-    if (!sourceFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, sourceFile.errorString()));
+  // files of different sizes can't be identical, no need to read them
+  if (destExists && checkContent && sourceInfo.size() == destInfo.size()) {
+    QString error;
+    srcHash = fileHash(sourceInfo, error);
+    if (srcHash.isEmpty()) {
+      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, error));
       ++m_stat.errored;
       return false;
     }
-    if (!destinationFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, destinationFile.errorString()));
+    const QByteArray destHash = fileHash(destInfo, error);
+    if (destHash.isEmpty()) {
+      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, error));
       ++m_stat.errored;
       return false;
     }
-
-    const bool skip = QCryptographicHash::hash(sourceFile.readAll(), QCryptographicHash::Md5) == QCryptographicHash::hash(destinationFile.readAll(), QCryptographicHash::Md5);
-    sourceFile.close();
-    destinationFile.close();
-    if (skip) {
+    if (srcHash == destHash) {
       PRINT_SKIP(tr("Skipping identical file: %1").arg(srcPath));
       ++m_stat.skipped;
       return true;
     }
-    checkContent = false;
   }
+  checkContent = false;
 
   if (!destExists || (!checkDate && !checkContent)) {
-    if (destInfo.exists()) {
-      existed = true;
+    if (destExists) {
       PRINT_REPLACE(tr("Replacing file: %1").arg(destPath));
-      if (!(m_options.flags & OPT_DRY_RUN) && !destinationFile.remove()) {
-        PRINT_ERROR(tr("Could not delete destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-        ++m_stat.errored;
-        return false;
-      }
     }
     else {
       PRINT_CREATE(tr("Creating file: %1").arg(destPath));
     }
-    if (!(m_options.flags & OPT_DRY_RUN) && !sourceFile.copy(destPath)) {
-      PRINT_ERROR(tr("Copy failed: '%1' to '%2': %3").arg(srcPath, destPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
+
+    if (m_options.flags & OPT_DRY_RUN) {
+      m_stat.bytes += sourceInfo.size();
+      if (destExists)
+        ++m_stat.updated;
+      else
+        ++m_stat.created;
     }
+    else {
+      m_manifest.remove(destInfo.absoluteFilePath());
+      queueCopy(srcPath, destPath, srcHash, sourceInfo.size(), destExists);
+    }
+  }
+
+  return true;
+}
+
+QByteArray SyncProcess::fileHash(const QFileInfo & fileInfo, QString & error)
+{
+  QByteArray result = m_manifest.hash(fileInfo);
+  if (!result.isEmpty())
+    return result;
+
+  QFile file(fileInfo.absoluteFilePath());
+  if (!file.open(QFile::ReadOnly)) {
+    error = file.errorString();
+    return QByteArray();
+  }
+
+  QCryptographicHash hash(SYNC_HASH_ALGORITHM);
+  QByteArray buffer(SYNC_HASH_CHUNK, Qt::Uninitialized);
+  qint64 len;
+  while ((len = file.read(buffer.data(), buffer.size())) > 0) {
+    hash.addData(buffer.constData(), len);
+  }
+  if (len < 0) {
+    error = file.errorString();
+    return QByteArray();
+  }
 
-    if (existed)
+  result = hash.result();
+  m_manifest.insert(fileInfo, result);
+  return result;
+}
+
+void SyncProcess::queueCopy(const QString & srcPath, const QString & destPath, const QByteArray & hash, qint64 size, bool existed)
+{
+  // keep the number of queued copies bounded so progress reporting stays accurate
+  waitForCopies(SYNC_COPY_QUEUE);
+
+  CopyResult request;
+  request.srcPath = srcPath;
+  request.destPath = destPath;
+  request.hash = hash;
+  request.size = size;
+  request.existed = existed;
+
+  m_copiesPending.ref();
+  m_copyPool.start(new SyncCopyTask(this, request));
+}
+
+void SyncProcess::copyFinished(const CopyResult & result)
+{
+  QMutexLocker locker(&m_copyMutex);
+  m_copyResults.append(result);
+  m_copiesPending.deref();
+}
+
+void SyncProcess::processCopyResults()
+{
+  QVector<CopyResult> results;
+  {
+    QMutexLocker locker(&m_copyMutex);
+    results.swap(m_copyResults);
+  }
+
+  for (const CopyResult & result : results) {
+    if (!result.error.isEmpty()) {
+      PRINT_ERROR(result.error);
+      ++m_stat.errored;
+      continue;
+    }
+    if (!result.hash.isEmpty())
+      m_manifest.insert(QFileInfo(result.destPath), result.hash);
+    // only the files actually copied count
+    m_stat.bytes += result.size;
+    if (result.existed)
       ++m_stat.updated;
     else
       ++m_stat.created;
   }
+}
 
-  return true;
+void SyncProcess::waitForCopies(int maxPending)
+{
+  while (m_copiesPending.load() > maxPending) {
+    if (m_copyPool.waitForDone(10))
+      break;
+    processCopyResults();
+    QApplication::processEvents();
+  }
+  processCopyResults();
+}
+
+QString SyncProcess::formatSize(qint64 bytes) const
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
+  return QLocale().formattedDataSize(bytes);
+#else
+  if (bytes < 1024 * 1024)
+    return tr("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+  return tr("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+#endif
 }
 
 void SyncProcess::pause()
@@ -26,10 +26,44 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QHash>
+#include <QMutex>
 #include <QReadWriteLock>
 #include <QRegExp>
+#include <QThreadPool>
 #include <QVector>
 
+// Persistent cache of file content hashes, indexed by absolute path.
+// A cached hash is only used while the file size and modification time
+// still match the ones recorded when it was computed.
+class SyncManifest
+{
+  public:
+    explicit SyncManifest(const QString & filename = QString());
+
+    bool load();
+    bool save(const QStringList & roots = QStringList());
+
+    QByteArray hash(const QFileInfo & fileInfo) const;
+    void insert(const QFileInfo & fileInfo, const QByteArray & hash);
+    void remove(const QString & path);
+    int count() const { return m_entries.count(); }
+
+    static QString defaultFilename();
+
+  protected:
+    struct Entry {
+      qint64 size;
+      qint64 modified;   // ms since epoch
+      qint64 checked;    // ms since epoch, when the hash was computed
+      QByteArray hash;
+    };
+
+    QString m_filename;
+    QHash<QString, Entry> m_entries;
+    bool m_dirty;
+};
+
 class SyncProcess : public QObject
 {
     Q_OBJECT
@@ -102,6 +136,7 @@ class SyncProcess : public QObject
         int updated;
         int skipped;
         int errored;
+        qint64 bytes;     // copied, or to be copied in a test run
         void clear() { memset(this, 0, sizeof(SyncStatus)); }
     };
 
@@ -121,8 +156,19 @@ class SyncProcess : public QObject
     void progressMessage(const QString & text, const int & type = QtInfoMsg, bool richText = false);
 
   protected:
+    friend class SyncCopyTask;
+
     enum FileFilterResult { FILE_ALLOW, FILE_OVERSIZE, FILE_EXCLUDE, FILE_LINK_IGNORE };
 
+    struct CopyResult {
+      QString srcPath;
+      QString destPath;
+      QString error;
+      QByteArray hash;
+      qint64 size;
+      bool existed;
+    };
+
     bool isStopRequsted();
     void finish();
     FileFilterResult fileFilter(const QFileInfo & fileInfo);
@@ -131,6 +177,12 @@ class SyncProcess : public QObject
     void updateDir(const QString & source, const QString & destination);
     void pushDirEntries(const QFileInfo & fi, QMutableListIterator<QFileInfo> &it);
     bool updateEntry(const QString & entry, const QDir & source, const QDir & destination);
+    QByteArray fileHash(const QFileInfo & fileInfo, QString & error);
+    void queueCopy(const QString & srcPath, const QString & destPath, const QByteArray & hash, qint64 size, bool existed);
+    void copyFinished(const CopyResult & result);
+    void processCopyResults();
+    void waitForCopies(int maxPending = 0);
+    QString formatSize(qint64 bytes) const;
     void pause();
     void emitProgressMessage(const QString &text, int type);
 
@@ -142,6 +194,11 @@ class SyncProcess : public QObject
     QStringList m_dirIteratorFilters;
     QDir::Filters m_dirFilters;
     QDateTime m_startTime;
+    SyncManifest m_manifest;
+    QThreadPool m_copyPool;
+    QMutex m_copyMutex;
+    QVector<CopyResult> m_copyResults;
+    QAtomicInt m_copiesPending;
     unsigned long m_pauseTime;
     bool stopping;
 };
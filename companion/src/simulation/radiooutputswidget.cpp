@@ -32,12 +32,15 @@
 extern AppData g;  // ensure what "g" means
 
 const quint16 RadioOutputsWidget::m_savedViewStateVersion = 2;
+const int RadioOutputsWidget::m_dataUpdateFreq = 40;  // ms
 
 RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware * firmware, QWidget *parent) :
   QWidget(parent),
   m_simulator(simulator),
   m_firmware(firmware),
   m_radioProfileId(g.sessionId()),
+  m_lastChanLimit(0),
+  m_lastSequence(0),
   ui(new Ui::RadioOutputsWidget)
 {
   ui->setupUi(this);
@@ -48,11 +51,10 @@ RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware
   connect(ui->channelsScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->mixersScroll->horizontalScrollBar(), &QScrollBar::setValue);
   connect(ui->mixersScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->channelsScroll->horizontalScrollBar(), &QScrollBar::setValue);
 
-  connect(m_simulator, &SimulatorInterface::channelOutValueChange, this, &RadioOutputsWidget::onChannelOutValueChange);
-  connect(m_simulator, &SimulatorInterface::channelMixValueChange, this, &RadioOutputsWidget::onChannelMixValueChange);
-  connect(m_simulator, &SimulatorInterface::virtualSwValueChange, this, &RadioOutputsWidget::onVirtSwValueChange);
-  connect(m_simulator, &SimulatorInterface::gVarValueChange, this, &RadioOutputsWidget::onGVarValueChange);
-  connect(m_simulator, &SimulatorInterface::phaseChanged, this, &RadioOutputsWidget::onPhaseChanged);
+  // outputs are pulled from the simulator at display rate
+  // rather than sent one signal per changed value
+  m_updateTimer.setInterval(m_dataUpdateFreq);
+  connect(&m_updateTimer, &QTimer::timeout, this, &RadioOutputsWidget::updateOutputs);
 }
 
 RadioOutputsWidget::~RadioOutputsWidget()
@@ -80,6 +82,10 @@ void RadioOutputsWidget::start()
   setupChannelsDisplay(true);
   setupGVarsDisplay();
   setupLsDisplay();
+
+  // new widgets: refresh all of them
+  m_lastSequence = 0;
+  m_updateTimer.start();
 }
 
 //void RadioOutputsWidget::stop()
@@ -303,6 +309,45 @@ QWidget * RadioOutputsWidget::createLogicalSwitch(QWidget * parent, int switchNo
   return swtch;
 }
 
+void RadioOutputsWidget::updateOutputs()
+{
+  SimulatorInterface::TxOutputsSnapshot snapshot;
+  if (!m_simulator->getOutputsSnapshot(snapshot) || snapshot.sequence == m_lastSequence)
+    return;
+
+  // snapshots may have been skipped since the last update:
+  // compare with the last values displayed instead of using the masks
+  const bool all = !m_lastSequence;
+  const SimulatorInterface::TxOutputs & out = snapshot.outputs;
+  const SimulatorInterface::TxOutputs & last = m_lastOutputs;
+
+  for (int i = 0; i < CPN_MAX_CHNOUT; i++) {
+    if (all || out.chans[i] != last.chans[i] || snapshot.chanLimit != m_lastChanLimit)
+      onChannelOutValueChange(i, out.chans[i], snapshot.chanLimit);
+    if (all || out.ex_chans[i] != last.ex_chans[i])
+      onChannelMixValueChange(i, out.ex_chans[i], 512 * 2 * 2);
+  }
+
+  for (int i = 0; i < CPN_MAX_LOGICAL_SWITCHES; i++) {
+    if (all || out.vsw[i] != last.vsw[i])
+      onVirtSwValueChange(i, out.vsw[i]);
+  }
+
+  for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++) {
+    for (int gv = 0; gv < CPN_MAX_GVARS; gv++) {
+      if (all || out.gvars[fm][gv] != last.gvars[fm][gv])
+        onGVarValueChange(gv, out.gvars[fm][gv]);
+    }
+  }
+
+  if (all || out.phase != last.phase)
+    onPhaseChanged(out.phase, QString());
+
+  m_lastOutputs = out;
+  m_lastChanLimit = snapshot.chanLimit;
+  m_lastSequence = snapshot.sequence;
+}
+
 void RadioOutputsWidget::onChannelOutValueChange(quint8 index, qint32 value, qint32 limit)
 {
   if (m_channelsMap.contains(index)) {
@@ -56,6 +56,7 @@ class RadioOutputsWidget : public QWidget
   protected slots:
     void saveState();
     void restoreState();
+    void updateOutputs();
     void onChannelOutValueChange(quint8 index, qint32 value, qint32 limit);
     void onChannelMixValueChange(quint8 index, qint32 value, qint32 limit);
     void onVirtSwValueChange(quint8 index, qint32 value);
@@ -78,9 +79,14 @@ class RadioOutputsWidget : public QWidget
     QHash<int, QHash<int, QLabel *> > m_globalVarsMap;      // m_globalVarsMap[gvarIndex][fmodeIndex] = QLabel*
 
     int m_radioProfileId;
-    int m_dataUpdateFreq;
+
+    QTimer m_updateTimer;
+    SimulatorInterface::TxOutputs m_lastOutputs;
+    qint32 m_lastChanLimit;
+    quint32 m_lastSequence;
 
     const static quint16 m_savedViewStateVersion;
+    const static int m_dataUpdateFreq;
 
   private:
     Ui::RadioOutputsWidget * ui;
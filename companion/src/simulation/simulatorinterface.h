@@ -118,6 +118,24 @@ class SimulatorInterface : public QObject
       // bool beep;
     };
 
+    // Published by the simulator once per cycle, the masks flag the values
+    // which changed since the previous snapshot (bit N = index N)
+    struct TxOutputsSnapshot {
+      TxOutputsSnapshot() { clear(); }
+      void clear() { memset(this, 0, sizeof(TxOutputsSnapshot)); }
+
+      TxOutputs outputs;
+      quint32 sequence;                  // 0: nothing published yet
+      qint32 chanLimit;                  // +/- range of outputs.chans
+      quint32 chansChanged;
+      quint32 exChansChanged;
+      quint64 vswChanged;
+      quint32 trimsChanged;
+      quint16 gvarsChanged[CPN_MAX_FLIGHT_MODES];
+      bool trimRangeChanged;
+      bool phaseChanged;
+    };
+
     virtual ~SimulatorInterface() {}
 
     virtual QString name() = 0;
@@ -127,6 +145,8 @@ class SimulatorInterface : public QObject
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0) = 0;
     virtual uint16_t getSensorRatio(uint16_t id) = 0;
     virtual const int getCapability(Capability cap) = 0;
+    // Copy of the last published outputs, can be called from any thread
+    virtual bool getOutputsSnapshot(TxOutputsSnapshot & snapshot) = 0;
 
   public slots:
 
@@ -23,7 +23,124 @@
 #include "firmwares/edgetx/edgetxinterface.h"
 #include "miniz.c"    //  Can only be included once!
 
+#include <algorithm>
+#include <atomic>
 #include <regex>
+#include <thread>
+
+static size_t zipDeviceRead(void * opaque, mz_uint64 offset, void * buffer, size_t size)
+{
+  QIODevice * device = (QIODevice *)opaque;
+  if (device->pos() != (qint64)offset && !device->seek(offset)) {
+    return 0;
+  }
+  qint64 len = device->read((char *)buffer, size);
+  return len < 0 ? 0 : len;
+}
+
+static size_t zipDeviceWrite(void * opaque, mz_uint64 offset, const void * buffer, size_t size)
+{
+  QIODevice * device = (QIODevice *)opaque;
+  if (device->pos() != (qint64)offset && !device->seek(offset)) {
+    return 0;
+  }
+  qint64 len = device->write((const char *)buffer, size);
+  return len < 0 ? 0 : len;
+}
+
+ZipArchiveReader::ZipArchiveReader(const QString & filename):
+  filename(filename),
+  valid(false)
+{
+  mz_zip_archive * reader = acquire();
+  if (reader) {
+    valid = true;
+    release(reader);
+  }
+}
+
+ZipArchiveReader::~ZipArchiveReader()
+{
+  foreach (mz_zip_archive * reader, readers) {
+    mz_zip_reader_end(reader);
+    delete (QFile *)reader->m_pIO_opaque;
+    delete reader;
+  }
+}
+
+mz_zip_archive * ZipArchiveReader::acquire()
+{
+  {
+    QMutexLocker locker(&mutex);
+    if (!available.isEmpty())
+      return available.takeLast();
+  }
+
+  QFile * file = new QFile(filename);
+  if (!file->open(QFile::ReadOnly)) {
+    delete file;
+    return nullptr;
+  }
+
+  mz_zip_archive * reader = new mz_zip_archive;
+  memset(reader, 0, sizeof(mz_zip_archive));
+  reader->m_pRead = zipDeviceRead;
+  reader->m_pIO_opaque = file;
+  if (!mz_zip_reader_init(reader, file->size(), 0)) {
+    delete file;
+    delete reader;
+    return nullptr;
+  }
+
+  QMutexLocker locker(&mutex);
+  readers.append(reader);
+  return reader;
+}
+
+void ZipArchiveReader::release(mz_zip_archive * reader)
+{
+  QMutexLocker locker(&mutex);
+  available.append(reader);
+}
+
+bool ZipArchiveReader::extract(QByteArray & fileData, const QString & fileName)
+{
+  mz_zip_archive * reader = acquire();
+  if (!reader) {
+    return false;
+  }
+
+  size_t size;
+  void * data = mz_zip_reader_extract_file_to_heap(reader, qPrintable(fileName), &size, 0);
+  release(reader);
+  if (!data) {
+    return false;
+  }
+
+  qDebug() << QString("Extracted file %1, size=%2").arg(fileName).arg(size);
+  fileData = QByteArray((const char *)data, size);
+  mz_free(data);
+  return true;
+}
+
+bool ZipArchiveReader::getFileList(std::list<std::string>& filelist)
+{
+  mz_zip_archive * reader = acquire();
+  if (!reader) {
+    return false;
+  }
+
+  int count = (int)mz_zip_reader_get_num_files(reader);
+  mz_zip_archive_file_stat file_stat;
+  for (int i=0; i<count; i++) {
+    if (!mz_zip_reader_file_stat(reader, i, &file_stat)) continue;
+    if (mz_zip_reader_is_file_a_directory(reader, i)) continue;
+    filelist.push_back(file_stat.m_filename);
+  }
+
+  release(reader);
+  return count > 0;
+}
 
 bool CategorizedStorageFormat::load(RadioData & radioData)
 {
@@ -60,6 +177,94 @@ StorageType CategorizedStorageFormat::probeFormat()
     return getStorageType(filename);
 }
 
+void CategorizedStorageFormat::parallelFor(int count, const std::function<void(int)> & function)
+{
+  int threads = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, count);
+
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    for (int i = next++; i < count; i = next++) {
+      function(i);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto & thread : workers) {
+    thread.join();
+  }
+}
+
+bool CategorizedStorageFormat::writeFiles(const std::vector<QByteArray> & filesData, const QStringList & fileNames)
+{
+  for (size_t i = 0; i < filesData.size(); i++) {
+    if (!writeFile(filesData[i], fileNames[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CategorizedStorageFormat::initZipWriter(mz_zip_archive * zip, QIODevice * device)
+{
+  memset(zip, 0, sizeof(mz_zip_archive));
+  zip->m_pWrite = zipDeviceWrite;
+  zip->m_pIO_opaque = device;
+  return mz_zip_writer_init(zip, 0);
+}
+
+int CategorizedStorageFormat::addZipFiles(mz_zip_archive * zip, const std::vector<QByteArray> & filesData, const QStringList & fileNames)
+{
+  struct CompressedFile {
+    void * data;
+    size_t size;
+    mz_uint32 crc;
+  };
+
+  int count = filesData.size();
+  std::vector<CompressedFile> compressed(count, {nullptr, 0, 0});
+  const int flags = tdefl_create_comp_flags_from_zip_params(MZ_DEFAULT_LEVEL, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+
+  // raw deflate streams, as miniz would produce them when adding the files
+  parallelFor(count, [&](int i) {
+    const QByteArray & data = filesData[i];
+    CompressedFile & file = compressed[i];
+    file.crc = (mz_uint32)mz_crc32(MZ_CRC32_INIT, (const mz_uint8 *)data.constData(), data.size());
+    file.data = tdefl_compress_mem_to_heap(data.constData(), data.size(), &file.size, flags);
+  });
+
+  int failed = -1;
+  for (int i = 0; i < count; i++) {
+    const QByteArray & data = filesData[i];
+    const CompressedFile & file = compressed[i];
+    std::string name = fileNames[i].toStdString();
+    bool added;
+    if (file.data && file.size < (size_t)data.size()) {
+      added = mz_zip_writer_add_mem_ex(zip, name.c_str(), file.data, file.size, nullptr, 0,
+                                       MZ_DEFAULT_LEVEL | MZ_ZIP_FLAG_COMPRESSED_DATA, data.size(), file.crc);
+    }
+    else {
+      // empty or incompressible file
+      added = mz_zip_writer_add_mem(zip, name.c_str(), data.constData(), data.size(), MZ_NO_COMPRESSION);
+    }
+    if (!added) {
+      failed = i;
+      break;
+    }
+  }
+
+  for (auto & file : compressed) {
+    mz_free(file.data);
+  }
+
+  return failed;
+}
+
 bool CategorizedStorageFormat::loadBin(RadioData & radioData)
 {
   QByteArray radioSettingsBuffer;
@@ -303,34 +508,47 @@ bool CategorizedStorageFormat::loadYaml(RadioData & radioData)
     }
   }
 
-  int modelIdx = 0;
   bool hasCategories = getCurrentFirmware()->getCapability(HasModelCategories);
-
-  radioData.models.resize(modelFiles.size());
-  for (const auto& mc : modelFiles) {
+  std::vector<EtxModelMetadata> files = { modelFiles.begin(), modelFiles.end() };
+  int count = files.size();
+
+  // Models are extracted and decoded in parallel, each one into its own slot.
+  //  Please note:
+  //  ModelData() use memset to clear everything to 0
+  //
+  radioData.models.resize(count);
+  std::vector<QString> errors(count);
+  parallelFor(count, [&](int modelIdx) {
+    const auto& mc = files[modelIdx];
     qDebug() << "Filename: " << mc.filename.c_str() << " / Category: " << mc.category;
 
     QByteArray modelBuffer;
     QString filename = "MODELS/" + QString::fromStdString(mc.filename);
     if (!loadFile(modelBuffer, filename)) {
-      setError(tr("Cannot extract ") + filename);
-      return false;
+      errors[modelIdx] = tr("Cannot extract ") + filename;
+      return;
     }
 
-    // Please note:
-    //  ModelData() use memset to clear everything to 0
-    //
-    auto& model = radioData.models[modelIdx];
-
     try {
-      if (!loadModelFromYaml(model,modelBuffer)) {
-        setError(tr("Cannot load ") + filename);
-        return false;
+      if (!loadModelFromYaml(radioData.models[modelIdx], modelBuffer)) {
+        errors[modelIdx] = tr("Cannot load ") + filename;
       }
     } catch(const std::runtime_error& e) {
-      setError(tr("Cannot load ") + filename + ":\n" + QString(e.what()));
+      errors[modelIdx] = tr("Cannot load ") + filename + ":\n" + QString(e.what());
+    }
+  });
+
+  // report the first failure, whatever the order the models were loaded in
+  for (const auto& error : errors) {
+    if (!error.isEmpty()) {
+      setError(error);
       return false;
     }
+  }
+
+  for (int modelIdx = 0; modelIdx < count; modelIdx++) {
+    const auto& mc = files[modelIdx];
+    auto& model = radioData.models[modelIdx];
 
     model.category = mc.category;
     model.modelIndex = modelIdx;
@@ -343,7 +561,6 @@ bool CategorizedStorageFormat::loadYaml(RadioData & radioData)
     }
 
     model.used = true;
-    modelIdx++;
   }
 
   return true;
@@ -387,6 +604,8 @@ bool CategorizedStorageFormat::writeYaml(const RadioData & radioData)
   }
 
   EtxModelfiles modelFiles;
+  std::vector<const ModelData *> models;
+  QStringList modelFilenames;
   for (const auto& model : radioData.models) {
 
     if (model.isEmpty())
@@ -404,11 +623,17 @@ bool CategorizedStorageFormat::writeYaml(const RadioData & radioData)
                           .arg(model.modelIndex, 2, 10, QLatin1Char('0'));
     }
 
-    QByteArray modelData;
-    writeModelToYaml(model, modelData);
-    if (!writeFile(modelData, modelFilename)) {
-      return false;
-    }
+    models.push_back(&model);
+    modelFilenames.append(modelFilename);
+  }
+
+  std::vector<QByteArray> modelsData(models.size());
+  parallelFor(models.size(), [&](int i) {
+    writeModelToYaml(*models[i], modelsData[i]);
+  });
+
+  if (!writeFiles(modelsData, modelFilenames)) {
+    return false;
   }
 
   if (hasCategories) {
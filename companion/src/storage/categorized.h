@@ -24,8 +24,35 @@
 #include "miniz.h"
 
 #include <QtCore>
+#include <functional>
 #include <list>
 #include <string>
+#include <vector>
+
+// Read access to a zip archive file from several threads. A miniz reader
+// keeps its state in the mz_zip_archive, so each extraction borrows a reader
+// of its own, with its own file handle, from a pool. Only the central
+// directory and the entries being extracted are read from the file.
+class ZipArchiveReader
+{
+  public:
+    explicit ZipArchiveReader(const QString & filename);
+    ~ZipArchiveReader();
+
+    bool isValid() const { return valid; }
+    bool extract(QByteArray & fileData, const QString & fileName);
+    bool getFileList(std::list<std::string> & filelist);
+
+  protected:
+    QString filename;
+    bool valid;
+    QMutex mutex;
+    QList<mz_zip_archive *> readers;
+    QList<mz_zip_archive *> available;
+
+    mz_zip_archive * acquire();
+    void release(mz_zip_archive * reader);
+};
 
 class CategorizedStorageFormat : public StorageFormat
 {
@@ -33,16 +60,25 @@ class CategorizedStorageFormat : public StorageFormat
 
   public:
     CategorizedStorageFormat(const QString & filename):
-      StorageFormat(filename)
+      StorageFormat(filename),
+      threadCount(0)
     {
     }
 
     virtual bool load(RadioData & radioData);
     virtual bool write(const RadioData & radioData);
 
+    // Number of threads used to load and save models, 0 for one per CPU core
+    void setThreadCount(unsigned count) { threadCount = count; }
+
   protected:
+    unsigned threadCount;
+
+    // loadFile() is called from several threads at once when loading models
     virtual bool loadFile(QByteArray & fileData, const QString & fileName) = 0;
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName) = 0;
+    // Writes the files in order, the default implementation calls writeFile()
+    virtual bool writeFiles(const std::vector<QByteArray> & filesData, const QStringList & fileNames);
     virtual bool getFileList(std::list<std::string>& filelist) = 0;
     virtual bool deleteFile(const QString & fileName) = 0;
 
@@ -52,4 +88,14 @@ class CategorizedStorageFormat : public StorageFormat
     virtual bool writeYaml(const RadioData & radioData);
 
     StorageType probeFormat();
+
+    // Runs function(0) .. function(count - 1) on up to threadCount threads
+    void parallelFor(int count, const std::function<void(int)> & function);
+
+    // Initializes a zip writer that writes the archive directly to device
+    static bool initZipWriter(mz_zip_archive * zip, QIODevice * device);
+
+    // Compresses the files in parallel and adds them to the archive in order.
+    // Returns the index of the file that could not be added, or -1.
+    int addZipFiles(mz_zip_archive * zip, const std::vector<QByteArray> & filesData, const QStringList & fileNames);
 };
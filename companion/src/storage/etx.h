@@ -30,7 +30,8 @@ class EtxFormat : public CategorizedStorageFormat
 
   public:
     EtxFormat(const QString & filename):
-      CategorizedStorageFormat(filename)
+      CategorizedStorageFormat(filename),
+      zip_reader(nullptr)
     {
     }
 
@@ -41,8 +42,10 @@ class EtxFormat : public CategorizedStorageFormat
   protected:
     virtual bool loadFile(QByteArray & fileData, const QString & fileName);
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName);
+    virtual bool writeFiles(const std::vector<QByteArray> & filesData, const QStringList & fileNames);
     virtual bool getFileList(std::list<std::string>& filelist);
     virtual bool deleteFile(const QString & fileName) { return false; }
 
-    mz_zip_archive zip_archive;
+    mz_zip_archive zip_archive;   // writer
+    ZipArchiveReader * zip_reader;
 };
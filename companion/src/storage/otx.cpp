@@ -20,8 +20,7 @@
 
 #include "otx.h"
 #include <QFile>
-
-#define MZ_ALLOCATION_SIZE    (32*1024)
+#include <QSaveFile>
 
 bool OtxFormat::load(RadioData & radioData)
 {
@@ -32,19 +31,19 @@ bool OtxFormat::load(RadioData & radioData)
     return false;
   }
 
-  QByteArray archiveContents = file.readAll();
-
-  qDebug() << "File" << filename << "read, size:" << archiveContents.size();
+  qDebug() << "File" << filename << "opened, size:" << file.size();
+  file.close();
 
-  // open zip file
-  memset(&zip_archive, 0, sizeof(zip_archive));
-  if (!mz_zip_reader_init_mem(&zip_archive, archiveContents.data(), archiveContents.size(), 0)) {
+  // open zip file, entries are read from it as they are extracted
+  ZipArchiveReader reader(filename);
+  if (!reader.isValid()) {
     qDebug() << tr("Error opening OpenTX archive %1").arg(filename);
     return false;
   }
 
+  zip_reader = &reader;
   bool result = CategorizedStorageFormat::load(radioData);
-  mz_zip_reader_end(&zip_archive);
+  zip_reader = nullptr;
   return result;
 }
 
@@ -52,37 +51,32 @@ bool OtxFormat::write(const RadioData & radioData)
 {
   qDebug() << "Saving to archive" << filename;
 
-  memset(&zip_archive, 0, sizeof(zip_archive));
-  if (!mz_zip_writer_init_heap(&zip_archive, 0, MZ_ALLOCATION_SIZE)) {
+  // the archive is written as it is built, and only replaces the previous
+  // file once complete
+  QSaveFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) {
+    setError(tr("Error creating OpenTX file %1:\n%2.").arg(filename).arg(file.errorString()));
+    return false;
+  }
+
+  if (!initZipWriter(&zip_archive, &file)) {
     setError(tr("Error initializing OpenTX archive writer"));
     return false;
   }
 
   bool result = CategorizedStorageFormat::write(radioData);
   if (result) {
-    // finalize archive and get contents
-    char * archiveContents;
-    size_t archiveSize;
-    if (mz_zip_writer_finalize_heap_archive(&zip_archive, (void **)&archiveContents, &archiveSize)) {
-      qDebug() << "Archive size" << archiveSize;
-      // write contents to file
-      QFile file(filename);
-      if (file.open(QIODevice::WriteOnly)) {
-        qint64 len = file.write(archiveContents, archiveSize);
-        if (len != (qint64)archiveSize) {
-          setError(tr("Error writing file %1:\n%2.").arg(filename).arg(file.errorString()));
-          result = false;
-        }
-      }
-      else {
-        setError(tr("Error creating OpenTX file %1:\n%2.").arg(filename).arg(file.errorString()));
-        result = false;
-      }
-    }
-    else {
+    if (!mz_zip_writer_finalize_archive(&zip_archive)) {
       setError(tr("Error creating OpenTX archive"));
       result = false;
     }
+    else if (!file.commit()) {
+      setError(tr("Error writing file %1:\n%2.").arg(filename).arg(file.errorString()));
+      result = false;
+    }
+    else {
+      qDebug() << "Archive size" << QFileInfo(filename).size();
+    }
   }
 
   mz_zip_writer_end(&zip_archive);
@@ -91,22 +85,13 @@ bool OtxFormat::write(const RadioData & radioData)
 
 bool OtxFormat::loadFile(QByteArray & filedata, const QString & filename)
 {
-  size_t size;
-  void * data = mz_zip_reader_extract_file_to_heap(&zip_archive, qPrintable(filename), &size, 0);
-  if (!data) {
-    return false;
-  }
-
-  qDebug() << QString("Extracted file %1, size=%2").arg(filename).arg(size);
-  filedata.clear();
-  filedata.append((char *)data, size);
-  mz_free(data);
-  return true;
+  return zip_reader && zip_reader->extract(filedata, filename);
 }
 
 bool OtxFormat::writeFile(const QByteArray & filedata, const QString & filename)
 {
-  if (!mz_zip_writer_add_mem(&zip_archive, filename.toStdString().c_str(), filedata.data(), filedata.size(), MZ_DEFAULT_LEVEL)) {
+  int failed = addZipFiles(&zip_archive, { filedata }, { filename });
+  if (failed >= 0) {
     setError(tr("Error adding %1 to OpenTX archive").arg(filename));
     return false;
   }
@@ -30,7 +30,8 @@ class OtxFormat : public CategorizedStorageFormat
 
   public:
     OtxFormat(const QString & filename):
-      CategorizedStorageFormat(filename)
+      CategorizedStorageFormat(filename),
+      zip_reader(nullptr)
     {
     }
 
@@ -44,5 +45,6 @@ class OtxFormat : public CategorizedStorageFormat
     virtual bool getFileList(std::list<std::string>& filelist) { return false; }
     virtual bool deleteFile(const QString & fileName) { return false; }
 
-    mz_zip_archive zip_archive;
+    mz_zip_archive zip_archive;   // writer
+    ZipArchiveReader * zip_reader;
 };
@@ -35,7 +35,8 @@ bool SdcardFormat::loadFile(QByteArray & filedata, const QString & filename)
   QString path = this->filename + "/" + filename;
   QFile file(path);
   if (!file.open(QFile::ReadOnly)) {
-    setError(tr("Error opening file %1:\n%2.").arg(path).arg(file.errorString()));
+    // called from several threads, the caller reports the error
+    qDebug() << "Error opening file" << path << ":" << file.errorString();
     return false;
   }
   filedata = file.readAll();
@@ -38,4 +38,11 @@ class OpenTxTest : public testing::Test
     }
 };
 
+// Benchmarks write large files and take long, they are only run when the
+// COMPANION_BENCHMARKS environment variable is set
+inline bool benchmarksEnabled()
+{
+  return !qEnvironmentVariableIsEmpty("COMPANION_BENCHMARKS");
+}
+
 #endif // _GTESTS_H_
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "gtests.h"
+#include "eeprominterface.h"
+#include "generalsettings.h"
+#include "modeldata.h"
+#include "compounditemmodels.h"
+
+#define EDITS_COUNT  100
+
+class ItemModelsTest : public testing::Test
+{
+  protected:
+    GeneralSettings generalSettings;
+    ModelData model;
+
+    // every entity the sources and switches depend on is in use
+    void SetUp()
+    {
+      Firmware::setCurrentVariant(Firmware::getFirmwareForFlavour("tx16s"));
+      Firmware * firmware = getCurrentFirmware();
+      generalSettings.variant = getCurrentBoard();
+
+      model.used = true;
+      model.setDefaultInputs(generalSettings);
+      model.setDefaultMixes(generalSettings);
+      for (int i = 0; i < firmware->getCapability(VirtualInputs); i++)
+        snprintf(model.inputNames[i], sizeof(model.inputNames[i]), "I%d", i);
+      for (int i = 0; i < firmware->getCapability(LogicalSwitches); i++)
+        model.logicalSw[i].func = LS_FN_VPOS;
+      for (int i = 0; i < firmware->getCapability(Sensors); i++)
+        snprintf(model.sensorData[i].label, sizeof(model.sensorData[i].label), "S%d", i);
+      for (int i = 0; i < firmware->getCapability(Gvars); i++)
+        snprintf(model.gvarData[i].name, sizeof(model.gvarData[i].name), "G%d", i);
+    }
+
+    static void addItemModels(CompoundItemModelFactory & factory)
+    {
+      factory.addItemModel(AbstractItemModel::IMID_RawSource);
+      factory.addItemModel(AbstractItemModel::IMID_RawSwitch);
+    }
+
+    static void expectSameItems(const CompoundItemModelFactory & expected, const CompoundItemModelFactory & actual)
+    {
+      for (int id : { AbstractItemModel::IMID_RawSource, AbstractItemModel::IMID_RawSwitch }) {
+        const AbstractItemModel * a = expected.getItemModel(id);
+        const AbstractItemModel * b = actual.getItemModel(id);
+        ASSERT_EQ(a->rowCount(), b->rowCount());
+        for (int i = 0; i < a->rowCount(); i++) {
+          EXPECT_EQ(a->item(i)->text(), b->item(i)->text()) << "model " << id << " row " << i;
+          EXPECT_EQ(a->item(i)->data(AbstractItemModel::IMDR_Available), b->item(i)->data(AbstractItemModel::IMDR_Available))
+            << "model " << id << " row " << i;
+        }
+      }
+    }
+
+    // renames sensor 3 and disables LS 12 or the reverse, then updates the item models
+    qint64 edit(CompoundItemModelFactory & factory, bool scoped)
+    {
+      QElapsedTimer timer;
+      timer.start();
+
+      for (int i = 0; i < EDITS_COUNT; i++) {
+        snprintf(model.sensorData[3].label, sizeof(model.sensorData[3].label), "E%d", i);
+        if (scoped)
+          factory.update(AbstractItemModel::IMUE_TeleSensors, 3);
+        else
+          factory.update(AbstractItemModel::IMUE_All);
+
+        model.logicalSw[11].func = (i & 1) ? LS_FN_VPOS : LS_FN_OFF;
+        if (scoped)
+          factory.update(AbstractItemModel::IMUE_LogicalSwitches, 11);
+        else
+          factory.update(AbstractItemModel::IMUE_All);
+      }
+
+      return timer.elapsed();
+    }
+};
+
+TEST_F(ItemModelsTest, scopedUpdate)
+{
+  CompoundItemModelFactory full(&generalSettings, &model);
+  addItemModels(full);
+  CompoundItemModelFactory scoped(&generalSettings, &model);
+  addItemModels(scoped);
+
+  int changes = 0;
+  int changedRows = 0;
+  AbstractItemModel * sources = scoped.getItemModel(AbstractItemModel::IMID_RawSource);
+  QObject::connect(sources, &QAbstractItemModel::dataChanged, [&](const QModelIndex & topLeft, const QModelIndex & bottomRight) {
+    changes++;
+    changedRows += bottomRight.row() - topLeft.row() + 1;
+  });
+
+  qint64 fullTime = edit(full, false);
+  qint64 scopedTime = edit(scoped, true);
+
+  qDebug() << EDITS_COUNT << "sensor and logical switch edits:" << fullTime << "ms with full updates," << scopedTime << "ms with scoped updates";
+
+  // the 3 telemetry sources of the renamed sensor, then the logical switch source, in one signal each
+  EXPECT_EQ(2 * EDITS_COUNT, changes);
+  EXPECT_EQ(4 * EDITS_COUNT, changedRows);
+
+  CompoundItemModelFactory reference(&generalSettings, &model);
+  addItemModels(reference);
+  expectSameItems(reference, full);
+  expectSameItems(reference, scoped);
+}
+
+TEST_F(ItemModelsTest, scopedUpdateRange)
+{
+  CompoundItemModelFactory factory(&generalSettings, &model);
+  addItemModels(factory);
+
+  // a shift from entity 10 to the end, as on insertion
+  memmove(&model.sensorData[11], &model.sensorData[10], (CPN_MAX_SENSORS - 11) * sizeof(SensorData));
+  model.sensorData[10].clear();
+  factory.update(AbstractItemModel::IMUE_TeleSensors, 10, -1);
+
+  CompoundItemModelFactory reference(&generalSettings, &model);
+  addItemModels(reference);
+  expectSameItems(reference, factory);
+
+  // an update of other entities leaves the items as they are
+  snprintf(model.gvarData[0].name, sizeof(model.gvarData[0].name), "X");
+  factory.update(AbstractItemModel::IMUE_GVars, 1, 2);
+  expectSameItems(reference, factory);
+
+  factory.update(AbstractItemModel::IMUE_GVars, 0);
+  AbstractItemModel * sources = factory.getItemModel(AbstractItemModel::IMID_RawSource);
+  int row = sources->rowCount() - getCurrentFirmware()->getCapability(Gvars);
+  EXPECT_EQ(RawSource(SOURCE_TYPE_GVAR, 0).toString(&model, &generalSettings), sources->item(row)->text());
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <cstring>
+
+#include "gtests.h"
+#include "logdata.h"
+
+class LogDataTest : public testing::Test
+{
+  protected:
+    QTemporaryDir dir;
+
+    QString writeLog(const QByteArray & content)
+    {
+      QString filename = dir.filePath("log.csv");
+      QFile file(filename);
+      EXPECT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+      file.write(content);
+      return filename;
+    }
+};
+
+static qint64 parseTimestamp(const char * date, const char * time)
+{
+  return LogData::parseTimestamp(date, date + strlen(date), time, time + strlen(time));
+}
+
+static qint64 utcTimestamp(int year, int month, int day, int h, int m, int s, int ms = 0)
+{
+  return QDateTime(QDate(year, month, day), QTime(h, m, s, ms), Qt::UTC).toMSecsSinceEpoch();
+}
+
+static QDateTime localTime(int h, int m, int s, int ms = 0)
+{
+  return QDateTime(QDate(2021, 6, 12), QTime(h, m, s, ms), Qt::LocalTime);
+}
+
+TEST(LogData, parseTimestamp)
+{
+  EXPECT_EQ(utcTimestamp(2021, 3, 28, 2, 30, 15, 250), parseTimestamp("2021-03-28", "02:30:15.250"));
+  EXPECT_EQ(utcTimestamp(2021, 3, 28, 2, 30, 15), parseTimestamp("2021-03-28", "02:30:15"));
+  EXPECT_EQ(utcTimestamp(2021, 3, 28, 2, 30, 15, 200), parseTimestamp("2021-03-28", "02:30:15.2"));
+  EXPECT_EQ(utcTimestamp(2020, 2, 29, 23, 59, 59, 999), parseTimestamp("2020-02-29", "23:59:59.999"));
+  EXPECT_EQ(utcTimestamp(1999, 12, 31, 0, 0, 0), parseTimestamp("1999-12-31", "00:00:00"));
+
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, parseTimestamp("2021-3-28", "02:30:15"));
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, parseTimestamp("2021-13-01", "02:30:15"));
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, parseTimestamp("2021-03-28", "24:00:00"));
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, parseTimestamp("2021-03-28", "02:30:15."));
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, parseTimestamp("2021-03-28", "02:30:15.2500"));
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, parseTimestamp("", ""));
+}
+
+TEST_F(LogDataTest, columnTypes)
+{
+  LogData log;
+  ASSERT_TRUE(log.load(writeLog(
+    "Date,Time,RSSI(dB),RxBt(V),GPS,Rud,SA\r\n"
+    "2021-06-12,10:00:00.000,45,4.9,45.123456 6.123456,-1024,1\r\n"
+    "2021-06-12,10:00:00.100,46,,45.123457 6.123457,0,\r\n"
+    "2021-06-12,10:00:00.200,47\r\n"
+    "2021-06-12,10:00:00.300,48,5.0,,1024,-1\r\n")));
+
+  EXPECT_EQ(7, log.columnCount());
+  EXPECT_EQ(3, log.rowCount());
+  EXPECT_EQ(4, log.totalLines());
+  EXPECT_EQ(1, log.invalidLines());
+  EXPECT_EQ(QString("RxBt(V)"), log.header().at(3));
+  EXPECT_EQ(4, log.findColumn("GPS"));
+
+  EXPECT_EQ(LogData::COLUMN_TEXT, log.columnType(0));
+  EXPECT_EQ(LogData::COLUMN_TEXT, log.columnType(1));
+  EXPECT_EQ(LogData::COLUMN_INT, log.columnType(2));
+  EXPECT_EQ(LogData::COLUMN_FLOAT, log.columnType(3));
+  EXPECT_EQ(LogData::COLUMN_TEXT, log.columnType(4));
+  EXPECT_EQ(LogData::COLUMN_INT, log.columnType(5));
+  EXPECT_EQ(LogData::COLUMN_INT, log.columnType(6));
+
+  EXPECT_EQ(48, log.value(2, 2));
+  EXPECT_FLOAT_EQ(4.9f, log.value(0, 3));
+  EXPECT_EQ(0, log.value(1, 3));
+  EXPECT_EQ(-1024, log.value(0, 5));
+  EXPECT_EQ(0, log.value(1, 6));
+
+  EXPECT_EQ(QString("45.123457 6.123457"), log.text(1, 4));
+  EXPECT_EQ(QString(""), log.text(2, 4));
+  EXPECT_EQ(QString("2021-06-12"), log.text(2, 0));
+  EXPECT_EQ(QString("-1"), log.text(2, 6));
+  EXPECT_EQ(QByteArray("2021-06-12,10:00:00.300,48,5.0,,1024,-1"), log.line(2));
+
+  EXPECT_EQ(localTime(10, 0, 0, 100), log.dateTime(1));
+  EXPECT_EQ(200, log.timestamp(2) - log.timestamp(1));
+}
+
+TEST_F(LogDataTest, wrongHeader)
+{
+  LogData log;
+  EXPECT_FALSE(log.load(writeLog("Time,Date,RSSI\n2021-06-12,10:00:00.000,45\n")));
+  EXPECT_TRUE(log.isEmpty());
+  EXPECT_FALSE(log.load(writeLog("")));
+  EXPECT_FALSE(log.load(dir.filePath("missing.csv")));
+}
+
+TEST_F(LogDataTest, sessions)
+{
+  LogData log;
+  ASSERT_TRUE(log.load(writeLog(
+    "Date,Time,Alt(m)\n"
+    "2021-06-12,10:00:00.000,1\n"
+    "2021-06-12,10:00:30.000,2\n"
+    "2021-06-12,10:01:30.900,3\n"
+    "2021-06-12,10:02:32.000,4\n"
+    "bad-date,10:02:33.000,5\n"
+    "2021-06-12,10:02:34.000,6\n"
+    "2021-06-12,11:00:00.000,7\n")));
+
+  QVector<int> starts = log.sessionStarts();
+  ASSERT_EQ(4, starts.size());
+  EXPECT_EQ(0, starts.at(0));
+  EXPECT_EQ(3, starts.at(1));
+  EXPECT_EQ(5, starts.at(2));
+  EXPECT_EQ(6, starts.at(3));
+
+  EXPECT_EQ(LogData::INVALID_TIMESTAMP, log.timestamp(4));
+  EXPECT_FALSE(log.dateTime(4).isValid());
+}
+
+// A log with every column type, one row every 20ms
+static QByteArray syntheticLog(int rows)
+{
+  QByteArray content("Date,Time,1RSS(dB),RQly(%),RxBt(V),Curr(A),Alt(m),VSpd(m/s),GPS,Rud,Ele,Thr,Ail,SA,SB,LSW\n");
+  content.reserve(rows * 110);
+
+  char buffer[160];
+  for (int i = 0; i < rows; i++) {
+    int ms = i * 20;
+    int length = snprintf(buffer, sizeof(buffer),
+      "2021-06-12,%02d:%02d:%02d.%03d,-%d,%d,%d.%d,%d.%02d,%d,%s%d.%d,45.%06d 6.%06d,%d,%d,%d,%d,%d,%d,0x%08X\n",
+      10 + ms / 3600000, (ms / 60000) % 60, (ms / 1000) % 60, ms % 1000,
+      40 + i % 60, 100 - i % 7, 4, i % 10, i % 30, i % 100, i % 500,
+      (i & 1) ? "-" : "", i % 5, i % 10,
+      i % 1000000, (i * 7) % 1000000,
+      i % 2049 - 1024, 1024 - i % 2049, i % 2049 - 1024, (i * 3) % 2049 - 1024,
+      (i / 1000) % 3 - 1, (i / 3000) % 3 - 1, i);
+    content.append(buffer, length);
+  }
+
+  return content;
+}
+
+static void checkSyntheticLog(const LogData & log, int rows, int row)
+{
+  EXPECT_EQ(rows, log.rowCount());
+  EXPECT_EQ(0, log.invalidLines());
+  EXPECT_EQ(1, log.sessionStarts().size());
+
+  EXPECT_EQ(LogData::COLUMN_INT, log.columnType(2));
+  EXPECT_EQ(LogData::COLUMN_FLOAT, log.columnType(4));
+  EXPECT_EQ(LogData::COLUMN_FLOAT, log.columnType(7));
+  EXPECT_EQ(LogData::COLUMN_TEXT, log.columnType(8));
+  EXPECT_EQ(LogData::COLUMN_INT, log.columnType(9));
+  EXPECT_EQ(LogData::COLUMN_TEXT, log.columnType(15));
+
+  EXPECT_EQ(-(40 + row % 60), log.value(row, 2));
+  EXPECT_FLOAT_EQ(4 + (row % 10) / 10.0f, log.value(row, 4));
+  EXPECT_FLOAT_EQ(((row & 1) ? -1 : 1) * (row % 5 + (row % 10) / 10.0f), log.value(row, 7));
+  EXPECT_EQ(row % 2049 - 1024, log.value(row, 9));
+  EXPECT_EQ(QString("45.%1 6.%2").arg(row % 1000000, 6, 10, QLatin1Char('0')).arg((row * 7) % 1000000, 6, 10, QLatin1Char('0')),
+            log.text(row, 8));
+  EXPECT_EQ(20, log.timestamp(row) - log.timestamp(row - 1));
+  EXPECT_EQ(localTime(10, 0, 0), log.dateTime(0));
+  EXPECT_EQ(localTime(10, 0, 0).addMSecs(qint64(row) * 20), log.dateTime(row));
+}
+
+TEST_F(LogDataTest, syntheticLog)
+{
+  const int rows = 5000;
+
+  LogData log;
+  ASSERT_TRUE(log.load(writeLog(syntheticLog(rows))));
+  checkSyntheticLog(log, rows, 3457);
+}
+
+TEST_F(LogDataTest, largeLogBenchmark)
+{
+  if (!benchmarksEnabled()) {
+    return;
+  }
+
+  const int rows = 1000000;
+
+  QElapsedTimer timer;
+  timer.start();
+  QByteArray content = syntheticLog(rows);
+  QString filename = writeLog(content);
+  qDebug() << "synthetic log of" << rows << "rows," << content.size() << "bytes written in" << timer.elapsed() << "ms";
+  content.clear();
+
+  LogData log;
+  timer.restart();
+  ASSERT_TRUE(log.load(filename));
+  qint64 loadTime = timer.elapsed();
+
+  timer.restart();
+  QVector<int> sessions = log.sessionStarts();
+  qint64 sessionsTime = timer.elapsed();
+
+  timer.restart();
+  double sum = 0;
+  for (int col = 2; col < log.columnCount(); col++) {
+    if (log.columnType(col) == LogData::COLUMN_TEXT)
+      continue;
+    for (int row = 0; row < log.rowCount(); row++) {
+      sum += log.value(row, col);
+    }
+  }
+  qint64 scanTime = timer.elapsed();
+
+  qDebug() << "loaded in" << loadTime << "ms, sessions in" << sessionsTime << "ms, columns scanned in" << scanTime << "ms" << sum;
+
+  EXPECT_EQ(1, sessions.size());
+  checkSyntheticLog(log, rows, 765432);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "gtests.h"
+#include "multimodelprinter.h"
+
+#define MODELS_COUNT  4
+
+class MultiModelPrinterTest : public testing::Test
+{
+  protected:
+    GeneralSettings generalSettings;
+    ModelData models[MODELS_COUNT];
+
+    // every mix, input, logical switch, special function, sensor and gvar in use
+    // the curves are left empty, their images need a GUI application
+    void SetUp()
+    {
+      Firmware::setCurrentVariant(Firmware::getFirmwareForFlavour("tx16s"));
+      Firmware * firmware = getCurrentFirmware();
+      generalSettings.variant = getCurrentBoard();
+
+      for (int m = 0; m < MODELS_COUNT; m++) {
+        ModelData & model = models[m];
+        model.used = true;
+        snprintf(model.name, sizeof(model.name), "Model %d", m);
+        model.setDefaultInputs(generalSettings);
+        model.setDefaultMixes(generalSettings);
+
+        for (int i = 0; i < CPN_MAX_EXPOS; i++) {
+          ExpoData & expo = model.expoData[i];
+          expo.chn = i % firmware->getCapability(VirtualInputs);
+          expo.mode = INPUT_MODE_BOTH;
+          expo.srcRaw = RawSource(SOURCE_TYPE_STICK, i % 4);
+          expo.weight = 100 - (i + m) % 50;
+        }
+        for (int i = 0; i < firmware->getCapability(Mixes); i++) {
+          MixData & mix = model.mixData[i];
+          mix.destCh = 1 + i % firmware->getCapability(Outputs);
+          mix.srcRaw = RawSource(SOURCE_TYPE_VIRTUAL_INPUT, i % 4);
+          mix.weight = 100 - (i * m) % 50;
+        }
+        for (int i = 0; i < firmware->getCapability(Outputs); i++) {
+          model.limitData[i].max = 1000 - i - m;
+        }
+        for (int i = 0; i < firmware->getCapability(LogicalSwitches); i++) {
+          model.logicalSw[i].func = LS_FN_VPOS;
+          model.logicalSw[i].val1 = RawSource(SOURCE_TYPE_STICK, i % 4).toValue();
+          model.logicalSw[i].val2 = (i + m) % 100;
+        }
+        for (int i = 0; i < firmware->getCapability(CustomFunctions); i++) {
+          model.customFn[i].swtch = RawSwitch(SWITCH_TYPE_VIRTUAL, 1 + i % firmware->getCapability(LogicalSwitches));
+          model.customFn[i].func = (AssignFunc)(FuncOverrideCH1 + i % firmware->getCapability(Outputs));
+          model.customFn[i].param = (i * m) % 100;
+        }
+        for (int i = 0; i < firmware->getCapability(Sensors); i++) {
+          snprintf(model.sensorData[i].label, sizeof(model.sensorData[i].label), "S%d", i);
+        }
+        for (int i = 0; i < firmware->getCapability(Gvars); i++) {
+          snprintf(model.gvarData[i].name, sizeof(model.gvarData[i].name), "G%d", i);
+        }
+      }
+    }
+
+    void setModels(MultiModelPrinter & printer)
+    {
+      printer.clearModels();
+      for (int m = 0; m < MODELS_COUNT; m++) {
+        printer.setModel(m, &models[m], &generalSettings);
+      }
+    }
+};
+
+TEST_F(MultiModelPrinterTest, styleRefresh)
+{
+  QElapsedTimer timer;
+
+  // a first print generates every section, as every refresh of the compare dialog used to
+  MultiModelPrinter uncached(getCurrentFirmware());
+  setModels(uncached);
+  timer.start();
+  QString first = uncached.print(nullptr);
+  qint64 uncachedTime = timer.elapsed();
+
+  MultiModelPrinter printer(getCurrentFirmware());
+  setModels(printer);
+  EXPECT_EQ(first, printer.print(nullptr));
+
+  // the compare dialog refreshed with the same models, e.g. after a style change
+  setModels(printer);
+  timer.restart();
+  QString cached = printer.print(nullptr);
+  qint64 cachedTime = timer.elapsed();
+
+  qDebug() << MODELS_COUNT << "models, style refresh in" << uncachedTime << "ms without the cache," << cachedTime << "ms with it," << first.size() << "characters";
+
+  EXPECT_EQ(first, cached);
+  const int sections = printer.cacheHits();
+  EXPECT_GT(sections, 0);
+
+  // a changed model only invalidates the sections it prints differently
+  models[2].mixData[5].weight = -37;
+  models[2].logicalSw[7].val2 = 1;
+  timer.restart();
+  QString changed = printer.print(nullptr);
+  qint64 changedTime = timer.elapsed();
+  qDebug() << MODELS_COUNT << "models, refresh after an edit in" << changedTime << "ms";
+  EXPECT_NE(first, changed);
+  EXPECT_EQ(sections - 2, printer.cacheHits());
+
+  MultiModelPrinter reference(getCurrentFirmware());
+  setModels(reference);
+  EXPECT_EQ(reference.print(nullptr), changed);
+}
+
+// copies of the compared models, e.g. read again from their file, are printed from the cache
+TEST_F(MultiModelPrinterTest, copiedModels)
+{
+  MultiModelPrinter printer(getCurrentFirmware());
+  setModels(printer);
+  QString first = printer.print(nullptr);
+  setModels(printer);
+  printer.print(nullptr);
+  const int sections = printer.cacheHits();
+
+  ModelData copies[MODELS_COUNT];
+  printer.clearModels();
+  for (int m = 0; m < MODELS_COUNT; m++) {
+    copies[m] = models[m];
+    printer.setModel(m, &copies[m], &generalSettings);
+  }
+  EXPECT_EQ(first, printer.print(nullptr));
+  EXPECT_EQ(sections, printer.cacheHits());
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include "gtests.h"
+#include "storage/etx.h"
+#include "firmwares/edgetx/edgetxinterface.h"
+
+#define MODELS_COUNT  64
+
+class EtxStorageTest : public testing::Test
+{
+  protected:
+    QTemporaryDir dir;
+    RadioData radioData;
+
+    void SetUp()
+    {
+      Firmware::setCurrentVariant(Firmware::getFirmwareForFlavour("tx16s"));
+      radioData.generalSettings.version = CPN_CURRENT_SETTINGS_VERSION;
+      radioData.generalSettings.variant = getCurrentBoard();
+      radioData.categories.push_back("Planes");
+      radioData.categories.push_back("Gliders");
+
+      for (int i = 0; i < MODELS_COUNT; i++) {
+        ModelData model;
+        model.used = true;
+        model.category = i % 2;
+        model.modelIndex = i;
+        snprintf(model.name, sizeof(model.name), "Model %d", i);
+        snprintf(model.filename, sizeof(model.filename), "model%02d.yml", i);
+        model.setDefaultInputs(radioData.generalSettings);
+        model.setDefaultMixes(radioData.generalSettings);
+        for (int j = 0; j < 4; j++) {
+          model.mixData[j].weight = 100 - (i + j) % 50;
+          model.expoData[j].weight = 50 + (i * j) % 50;
+          model.limitData[j].max = 1000 - i;
+        }
+        radioData.models.push_back(model);
+      }
+    }
+
+    // Writes the archive with miniz directly, so that loading does not depend
+    // on the way EtxFormat writes it
+    QString writeArchive(const QString & name, int skippedModel = -1, int brokenModel = -1, int soundsSize = 0)
+    {
+      QString path = dir.filePath(name);
+      mz_zip_archive zip;
+      memset(&zip, 0, sizeof(zip));
+      EXPECT_TRUE(mz_zip_writer_init_file(&zip, qPrintable(path), 0));
+
+      QByteArray data;
+      EXPECT_TRUE(writeRadioSettingsToYaml(radioData.generalSettings, data));
+      EXPECT_TRUE(mz_zip_writer_add_mem(&zip, "RADIO/radio.yml", data.constData(), data.size(), MZ_DEFAULT_LEVEL));
+
+      EtxModelfiles modelFiles;
+      for (int i = 0; i < MODELS_COUNT; i++) {
+        const ModelData & model = radioData.models[i];
+        modelFiles.push_back({model.filename, model.name, model.category, i});
+        if (i == skippedModel)
+          continue;
+        if (i == brokenModel)
+          data = "timers: [\n";
+        else
+          writeModelToYaml(model, data);
+        QString filename = QString("MODELS/%1").arg(model.filename);
+        EXPECT_TRUE(mz_zip_writer_add_mem(&zip, qPrintable(filename), data.constData(), data.size(), MZ_DEFAULT_LEVEL));
+      }
+
+      EXPECT_TRUE(writeModelsListToYaml(radioData.categories, modelFiles, data));
+      EXPECT_TRUE(mz_zip_writer_add_mem(&zip, "MODELS/models.yml", data.constData(), data.size(), MZ_DEFAULT_LEVEL));
+
+      // sounds bundled with the models, as 1MB of noise each
+      QByteArray sound(1024 * 1024, 0);
+      uint32_t seed = 1;
+      for (int j = 0; j < sound.size(); j++) {
+        seed = seed * 1103515245 + 12345;
+        sound[j] = seed >> 16;
+      }
+      for (int i = 0; i < soundsSize; i++) {
+        QString filename = QString("SOUNDS/en/sound%1.wav").arg(i, 3, 10, QLatin1Char('0'));
+        EXPECT_TRUE(mz_zip_writer_add_mem(&zip, qPrintable(filename), sound.constData(), sound.size(), MZ_NO_COMPRESSION));
+      }
+
+      EXPECT_TRUE(mz_zip_writer_finalize_archive(&zip));
+      mz_zip_writer_end(&zip);
+      return path;
+    }
+
+    static void expectSameModels(const RadioData & expected, const RadioData & actual)
+    {
+      ASSERT_EQ(expected.models.size(), actual.models.size());
+      for (size_t i = 0; i < expected.models.size(); i++) {
+        const ModelData & a = expected.models[i];
+        const ModelData & b = actual.models[i];
+        EXPECT_STREQ(a.name, b.name);
+        EXPECT_STREQ(a.filename, b.filename);
+        EXPECT_EQ(a.category, b.category);
+        EXPECT_EQ(a.modelIndex, b.modelIndex);
+        EXPECT_EQ(a.used, b.used);
+        QByteArray yamlA, yamlB;
+        writeModelToYaml(a, yamlA);
+        writeModelToYaml(b, yamlB);
+        EXPECT_EQ(yamlA, yamlB) << "model " << i;
+      }
+    }
+};
+
+TEST_F(EtxStorageTest, parallelLoad)
+{
+  QString path = writeArchive("models.etx");
+
+  QElapsedTimer timer;
+  RadioData sequential;
+  EtxFormat sequentialFormat(path);
+  sequentialFormat.setThreadCount(1);
+  timer.start();
+  ASSERT_TRUE(sequentialFormat.load(sequential));
+  qint64 sequentialTime = timer.elapsed();
+
+  RadioData parallel;
+  EtxFormat parallelFormat(path);
+  parallelFormat.setThreadCount(8);
+  timer.restart();
+  ASSERT_TRUE(parallelFormat.load(parallel));
+  qint64 parallelTime = timer.elapsed();
+
+  qDebug() << MODELS_COUNT << "models loaded in" << sequentialTime << "ms on one thread," << parallelTime << "ms on 8 threads";
+
+  ASSERT_EQ((size_t)MODELS_COUNT, parallel.models.size());
+  EXPECT_EQ(radioData.categories.size(), parallel.categories.size());
+  expectSameModels(sequential, parallel);
+  EXPECT_STREQ("Model 37", parallel.models[37].name);
+  EXPECT_EQ(1, parallel.models[37].category);
+  EXPECT_EQ(radioData.models[37].mixData[2].weight, parallel.models[37].mixData[2].weight);
+}
+
+TEST_F(EtxStorageTest, parallelWrite)
+{
+  QString path = dir.filePath("written.etx");
+  EtxFormat writer(path);
+  writer.setThreadCount(8);
+  ASSERT_TRUE(writer.write(radioData));
+
+  RadioData written;
+  EtxFormat sequentialFormat(path);
+  sequentialFormat.setThreadCount(1);
+  ASSERT_TRUE(sequentialFormat.load(written));
+
+  RadioData reference;
+  EtxFormat referenceFormat(writeArchive("reference.etx"));
+  referenceFormat.setThreadCount(1);
+  ASSERT_TRUE(referenceFormat.load(reference));
+
+  expectSameModels(reference, written);
+}
+
+// Peak resident memory in kB, -1 if not available
+static qint64 peakMemoryUsage()
+{
+  QFile status("/proc/self/status");
+  if (!status.open(QIODevice::ReadOnly))
+    return -1;
+
+  foreach (const QByteArray & line, status.readAll().split('\n')) {
+    if (line.startsWith("VmHWM:"))
+      return line.mid(6).trimmed().split(' ').first().toLongLong();
+  }
+
+  return -1;
+}
+
+// Resets the peak resident memory to the current usage
+static bool resetPeakMemoryUsage()
+{
+  QFile clearRefs("/proc/self/clear_refs");
+  return clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("5") == 1;
+}
+
+// The sounds bundled with the models are left in the archive
+TEST_F(EtxStorageTest, bundledSounds)
+{
+  RadioData loaded;
+  EtxFormat format(writeArchive("sounds.etx", -1, -1, 4));
+  ASSERT_TRUE(format.load(loaded));
+
+  RadioData reference;
+  EtxFormat referenceFormat(writeArchive("reference.etx"));
+  ASSERT_TRUE(referenceFormat.load(reference));
+
+  expectSameModels(reference, loaded);
+}
+
+TEST_F(EtxStorageTest, largeArchiveBenchmark)
+{
+  if (!benchmarksEnabled()) {
+    return;
+  }
+
+  const int soundsSize = 200;  // MB
+
+  QElapsedTimer timer;
+  timer.start();
+  QString path = writeArchive("large.etx", -1, -1, soundsSize);
+  qint64 archiveSize = QFileInfo(path).size();
+  qDebug() << "archive of" << archiveSize << "bytes written in" << timer.elapsed() << "ms";
+
+  RadioData loaded;
+  EtxFormat format(path);
+  bool peakAvailable = resetPeakMemoryUsage();
+  qint64 before = peakMemoryUsage();
+  timer.restart();
+  ASSERT_TRUE(format.load(loaded));
+  qint64 loadTime = timer.elapsed();
+  qint64 peak = peakMemoryUsage();
+
+  QString savedPath = dir.filePath("saved.etx");
+  EtxFormat saved(savedPath);
+  timer.restart();
+  ASSERT_TRUE(saved.write(loaded));
+  qint64 saveTime = timer.elapsed();
+
+  qDebug() << "loaded in" << loadTime << "ms, saved in" << saveTime << "ms, peak memory" << before << "->" << peak << "kB";
+
+  EXPECT_EQ((size_t)MODELS_COUNT, loaded.models.size());
+  if (peakAvailable && before >= 0 && peak >= 0) {
+    // the archive is read one entry at a time, not in full
+    EXPECT_LT(peak - before, archiveSize / 1024 / 4);
+  }
+
+  RadioData reloaded;
+  EtxFormat reloadFormat(savedPath);
+  ASSERT_TRUE(reloadFormat.load(reloaded));
+  expectSameModels(loaded, reloaded);
+}
+
+TEST_F(EtxStorageTest, firstErrorReported)
+{
+  for (int threads = 1; threads <= 8; threads *= 8) {
+    RadioData loaded;
+    EtxFormat missing(writeArchive("missing.etx", 40));
+    missing.setThreadCount(threads);
+    EXPECT_FALSE(missing.load(loaded));
+    EXPECT_EQ(QString("Cannot extract MODELS/model40.yml"), missing.error());
+
+    // several failures: the one of the lowest model index wins
+    EtxFormat broken(writeArchive("broken.etx", 50, 12));
+    broken.setThreadCount(threads);
+    EXPECT_FALSE(broken.load(loaded));
+    EXPECT_TRUE(broken.error().startsWith("Cannot load MODELS/model12.yml")) << qPrintable(broken.error());
+  }
+}
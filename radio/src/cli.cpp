@@ -1448,6 +1448,14 @@ int cliShowJitter(const char ** argv)
       }
     }
   }
+#if defined(STM32) && !defined(SIMU)
+  if (getSelectedUsbMode() == USB_JOYSTICK_MODE) {
+    // current measurement window, then jitter over the last second (us)
+    cliSerialPrint("USB latency %d-%d jitter %d, interval %d-%d jitter %d",
+                   usbJoystickLatency.min / 2, usbJoystickLatency.max / 2, usbJoystickLatency.get() / 2,
+                   usbJoystickInterval.min / 2, usbJoystickInterval.max / 2, usbJoystickInterval.get() / 2);
+  }
+#endif
   return 0;
 }
 #endif
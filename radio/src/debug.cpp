@@ -234,6 +234,7 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"ADC read   "   // debugTimerAdcRead,
   ,"mix-pulses "   // debugTimerMixerCalcToUsage
   ,"mix-int.   "   // debugTimerMixerIterval
+  ,"mix-mutex  "   // debugTimerMixerMutex
   ,"Audio int. "   // debugTimerAudioIterval
   ,"Audio dur. "   // debugTimerAudioDuration
   ," A. consume"   // debugTimerAudioConsume,
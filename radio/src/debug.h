@@ -385,6 +385,7 @@ enum DebugTimers {
 
   debugTimerMixerCalcToUsage,
   debugTimerMixerIterval,
+  debugTimerMixerMutex,
 
   debugTimerAudioIterval,
   debugTimerAudioDuration,
@@ -121,6 +121,52 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
   }
 }
 
+// The switches triggering the functions, evaluated once per tick whatever the
+// number of functions sharing them. Telemetry switches are not cached, as a
+// function may reset the telemetry before the next ones are evaluated.
+#define FUNCTION_TRIGGERS_MAX 16
+
+class FunctionTriggers
+{
+  public:
+    bool getSwitch(swsrc_t swtch, uint8_t flags)
+    {
+      uint8_t idx = abs(swtch);
+      if (idx >= SWSRC_TELEMETRY_STREAMING) {
+        return ::getSwitch(swtch, flags);
+      }
+
+      bool state;
+      uint8_t i = 0;
+      while (i < count && (triggers[i].idx != idx || triggers[i].flags != flags)) {
+        i++;
+      }
+
+      if (i < count) {
+        state = triggers[i].state;
+      }
+      else {
+        state = ::getSwitch(idx, flags);
+        if (count < FUNCTION_TRIGGERS_MAX) {
+          triggers[count++] = {idx, flags, state};
+        }
+      }
+
+      return swtch > 0 ? state : !state;
+    }
+
+  protected:
+    struct {
+      uint8_t idx;
+      uint8_t flags;
+      bool state;
+    } triggers[FUNCTION_TRIGGERS_MAX];
+    uint8_t count = 0;
+};
+
+// safetyCh[] and trimGvar[] only need a reset when a function has set them
+static bool overridesSet = true;
+
 #define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
 getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
 
@@ -128,21 +174,25 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
 {
   MASK_FUNC_TYPE newActiveFunctions  = 0;
   MASK_CFN_TYPE  newActiveSwitches = 0;
+  FunctionTriggers triggers;
 
   uint8_t playFirstIndex = (functions == g_model.customFn ? 1 : 1+MAX_SPECIAL_FUNCTIONS);
   #define PLAY_INDEX   (i+playFirstIndex)
 
+  if (overridesSet) {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
-  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
-    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
-  }
+    for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+    }
 #endif
 
 #if defined(GVARS)
-  for (uint8_t i=0; i<NUM_TRIMS; i++) {
-    trimGvar[i] = -1;
-  }
+    for (uint8_t i=0; i<NUM_TRIMS; i++) {
+      trimGvar[i] = -1;
+    }
 #endif
+    overridesSet = false;
+  }
 
   for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
     const CustomFunctionData * cfn = &functions[i];
@@ -150,7 +200,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
     if (swtch) {
       MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
 
-      bool active = getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+      bool active = triggers.getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
 
       if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
         active &= (bool)CFN_ACTIVE(cfn);
@@ -162,6 +212,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
           case FUNC_OVERRIDE_CHANNEL:
             safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
+            overridesSet = true;
             break;
 #endif
 
@@ -245,6 +296,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
             }
             else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM && CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
               trimGvar[CFN_PARAM(cfn)-MIXSRC_FIRST_TRIM] = CFN_GVAR_INDEX(cfn);
+              overridesSet = true;
             }
             else {
               SET_GVAR(CFN_GVAR_INDEX(cfn), limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)), calcRESXto100(getValue(CFN_PARAM(cfn))), MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))), mixerCurrentFlightMode);
@@ -38,6 +38,7 @@
  */
 
 #include "opentx.h"
+#include "gps_ubx.h"
 #include <ctype.h>
 
 gpsdata_t gpsData;
@@ -308,15 +309,85 @@ bool gpsNewFrameNMEA(char c)
   return frameOK;
 }
 
-bool gpsNewFrame(uint8_t c)
+#if !defined(GPS_UBX_BAUDRATE)
+  #define GPS_UBX_BAUDRATE        115200
+#endif
+
+#define GPS_UBX_MEAS_RATE         100 // ms (10 Hz)
+
+// timeouts in 10ms ticks
+#define GPS_UBX_BAUDRATE_DELAY    10  // CFG-PRT sent at the initial baudrate
+#define GPS_UBX_DETECT_TIMEOUT    300 // no NAV-PVT: fallback to NMEA
+#define GPS_UBX_LOST_TIMEOUT      500 // no NAV-PVT anymore: configure again
+
+enum GpsProtocolState {
+  GPS_PROTOCOL_UBX_CONFIG,
+  GPS_PROTOCOL_UBX_BAUDRATE,
+  GPS_PROTOCOL_UBX_DETECT,
+  GPS_PROTOCOL_UBX,
+  GPS_PROTOCOL_NMEA,
+};
+
+static uint8_t gpsProtocolState = GPS_PROTOCOL_UBX_CONFIG;
+static tmr10ms_t gpsProtocolTimer;
+static ubx_parser_t gpsUbxParser;
+
+static void gpsProcessNavPvt(const ubx_nav_pvt_t& pvt)
 {
-  return gpsNewFrameNMEA(c);
+  gpsData.fix = (pvt.flags & 0x01) && pvt.fixType >= 2;
+  gpsData.numSat = pvt.numSV;
+  // NAV-PVT has no HDOP: PDOP is an upper bound
+  gpsData.hdop = pvt.pDOP;
+  if (gpsData.fix) {
+    __disable_irq();    // do the atomic update of lat/lon
+    gpsData.latitude = pvt.lat / 10;
+    gpsData.longitude = pvt.lon / 10;
+    gpsData.altitude = pvt.hMSL > 0 ? pvt.hMSL / 1000 : 0;
+    __enable_irq();
+  }
+  gpsData.speed = pvt.gSpeed / 10;  // mm/s to cm/s, as the NMEA RMC speed
+  gpsData.groundCourse = pvt.headMot / 10000;
+
+#if defined(RTCLOCK)
+  // set RTC clock if needed
+  if (g_eeGeneral.adjustRTC && gpsData.fix && (pvt.valid & 0x03) == 0x03) {
+    rtcAdjust(pvt.year, pvt.month, pvt.day, pvt.hour, pvt.min, pvt.sec);
+  }
+#endif
 }
 
-void gpsNewData(uint8_t c)
+static void gpsNewUbxMessage()
 {
-  if (!gpsNewFrame(c)) {
-    return;
+  ubx_nav_pvt_t pvt;
+  if (ubxDecodeNavPvt(&gpsUbxParser, &pvt)) {
+    gpsData.packetCount++;
+    gpsProtocolState = GPS_PROTOCOL_UBX;
+    gpsProtocolTimer = get_tmr10ms();
+    gpsProcessNavPvt(pvt);
+  }
+}
+
+void gpsNewData(const uint8_t* data, uint32_t len)
+{
+  while (len > 0) {
+    // NMEA is plain ASCII: UBX_SYNC1 cannot be part of it
+    if (!ubxParserBusy(&gpsUbxParser) && *data != UBX_SYNC1) {
+      gpsNewFrameNMEA(*data++);
+      len--;
+      continue;
+    }
+
+    UbxResult result;
+    size_t consumed = ubxParse(&gpsUbxParser, data, len, &result);
+    data += consumed;
+    len -= consumed;
+
+    if (result == UBX_MESSAGE) {
+      gpsNewUbxMessage();
+    }
+    else if (result == UBX_CHECKSUM_ERROR) {
+      gpsData.errorCount++;
+    }
   }
 }
 
@@ -331,23 +402,139 @@ void gpsSetSerialDriver(void* ctx, const etx_serial_driver_t* drv)
 {
   gpsSerialCtx = ctx;
   gpsSerialDrv = drv;
+  gpsProtocolState = GPS_PROTOCOL_UBX_CONFIG;
+  ubxParserInit(&gpsUbxParser);
+}
+
+static void gpsSetBaudrate(uint32_t baudrate)
+{
+  if (!gpsSerialDrv->init || !gpsSerialDrv->deinit) return;
+
+  etx_serial_init params = {
+    .baudrate = baudrate,
+    .parity = ETX_Parity_None,
+    .stop_bits = ETX_StopBits_One,
+    .word_length = ETX_WordLength_8,
+    .rx_enable = true,
+  };
+
+  // AUX drivers return the same context on each init
+  gpsSerialDrv->deinit(gpsSerialCtx);
+  gpsSerialCtx = gpsSerialDrv->init(&params);
+}
+
+static void gpsSendUbx(uint8_t msgClass, uint8_t msgId,
+                       const uint8_t* payload, uint16_t length)
+{
+  auto _sendBuffer = gpsSerialDrv->sendBuffer;
+  if (!_sendBuffer) return;
+
+  uint8_t frame[32];
+  if (length + UBX_FRAME_OVERHEAD > sizeof(frame)) return;
+
+  size_t size = ubxBuildFrame(frame, msgClass, msgId, payload, length);
+  _sendBuffer(gpsSerialCtx, frame, size);
+}
+
+// UART1: UBX output only (NMEA still accepted as input)
+static void gpsSendUbxPortConfig()
+{
+  uint32_t baudrate = GPS_UBX_BAUDRATE;
+  const uint8_t payload[] = {
+    0x01,       // portID: UART1
+    0x00,       // reserved
+    0x00, 0x00, // txReady
+    0xD0, 0x08, 0x00, 0x00,  // mode: 8N1
+    (uint8_t)baudrate, (uint8_t)(baudrate >> 8),
+    (uint8_t)(baudrate >> 16), (uint8_t)(baudrate >> 24),
+    0x03, 0x00, // inProtoMask: UBX + NMEA
+    0x01, 0x00, // outProtoMask: UBX
+    0x00, 0x00, // flags
+    0x00, 0x00, // reserved
+  };
+  gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_PRT, payload, sizeof(payload));
+}
+
+static void gpsSendUbxNavConfig()
+{
+  // NAV-PVT on every solution
+  const uint8_t msg[] = { UBX_CLASS_NAV, UBX_NAV_PVT, 0x01 };
+  gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_MSG, msg, sizeof(msg));
+
+  const uint8_t rate[] = {
+    GPS_UBX_MEAS_RATE & 0xFF, GPS_UBX_MEAS_RATE >> 8, // measRate
+    0x01, 0x00, // navRate
+    0x01, 0x00, // timeRef: GPS
+  };
+  gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_RATE, rate, sizeof(rate));
+}
+
+// Try to switch u-blox receivers to UBX NAV-PVT at a higher rate and
+// baudrate, and fallback to NMEA at the default baudrate otherwise
+static void gpsCheckProtocol()
+{
+  tmr10ms_t elapsed = get_tmr10ms() - gpsProtocolTimer;
+
+  switch (gpsProtocolState) {
+    case GPS_PROTOCOL_UBX_CONFIG:
+      gpsSendUbxPortConfig();
+      gpsProtocolTimer = get_tmr10ms();
+      gpsProtocolState = GPS_PROTOCOL_UBX_BAUDRATE;
+      break;
+
+    case GPS_PROTOCOL_UBX_BAUDRATE:
+      if (elapsed >= GPS_UBX_BAUDRATE_DELAY) {
+        gpsSetBaudrate(GPS_UBX_BAUDRATE);
+        gpsSendUbxNavConfig();
+        gpsProtocolTimer = get_tmr10ms();
+        gpsProtocolState = GPS_PROTOCOL_UBX_DETECT;
+      }
+      break;
+
+    case GPS_PROTOCOL_UBX_DETECT:
+      if (elapsed >= GPS_UBX_DETECT_TIMEOUT) {
+        TRACE("GPS: no UBX, using NMEA");
+        gpsSetBaudrate(GPS_USART_BAUDRATE);
+        gpsProtocolState = GPS_PROTOCOL_NMEA;
+      }
+      break;
+
+    case GPS_PROTOCOL_UBX:
+      if (elapsed >= GPS_UBX_LOST_TIMEOUT) {
+        // receiver probably restarted with its default configuration
+        TRACE("GPS: UBX lost");
+        gpsSetBaudrate(GPS_USART_BAUDRATE);
+        gpsProtocolState = GPS_PROTOCOL_UBX_CONFIG;
+      }
+      break;
+  }
 }
 
 void gpsWakeup()
 {
   if (!gpsSerialDrv) return;
+
+  gpsCheckProtocol();
   
   auto _getByte = gpsSerialDrv->getByte;
   if (!_getByte) return;
 
-  uint8_t byte;
-  while (_getByte(gpsSerialCtx, &byte)) {
+  uint8_t buffer[32];
+  uint32_t len = 0;
+  while (_getByte(gpsSerialCtx, &buffer[len])) {
 #if defined(DEBUG)
     if (gpsTraceEnabled) {
-      dbgSerialPutc(byte);
+      dbgSerialPutc(buffer[len]);
     }
-#endif  
-    gpsNewData(byte);
+#endif
+    if (++len == sizeof(buffer)) {
+      gpsNewData(buffer, len);
+      len = 0;
+    }
+  }
+
+  if (len > 0) {
+    gpsNewData(buffer, len);
   }
 }
 
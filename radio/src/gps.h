@@ -33,7 +33,7 @@ struct gpsdata_t
   uint32_t packetCount;
   uint32_t errorCount;
   uint16_t altitude;              // altitude in 0.1m
-  uint16_t speed;                 // speed in 0.1m/s
+  uint16_t speed;                 // speed in cm/s
   uint16_t groundCourse;          // degrees * 10
   uint16_t hdop;
 };
@@ -50,6 +50,9 @@ void gpsSetSerialDriver(void* ctx, const etx_serial_driver_t* drv);
 // Periodic processing
 void gpsWakeup();
 
+// Process received data (UBX and NMEA)
+void gpsNewData(const uint8_t* data, uint32_t len);
+
 // Send a 0-terminated frame
 void gpsSendFrame(const char * frame);
 
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gps_ubx.h"
+#include <string.h>
+
+enum UbxParserState {
+  UBX_STATE_SYNC1,
+  UBX_STATE_SYNC2,
+  UBX_STATE_CLASS,
+  UBX_STATE_ID,
+  UBX_STATE_LENGTH1,
+  UBX_STATE_LENGTH2,
+  UBX_STATE_PAYLOAD,
+  UBX_STATE_CK_A,
+  UBX_STATE_CK_B,
+};
+
+static inline void ubxChecksum(uint8_t& ckA, uint8_t& ckB, uint8_t c)
+{
+  ckA += c;
+  ckB += ckA;
+}
+
+static inline uint16_t ubxGetU2(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t ubxGetU4(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void ubxParserInit(ubx_parser_t* parser)
+{
+  parser->state = UBX_STATE_SYNC1;
+}
+
+bool ubxParserBusy(const ubx_parser_t* parser)
+{
+  return parser->state != UBX_STATE_SYNC1;
+}
+
+size_t ubxParse(ubx_parser_t* parser, const uint8_t* data, size_t len,
+                UbxResult* result)
+{
+  *result = UBX_NONE;
+
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = data[i];
+
+    switch (parser->state) {
+      case UBX_STATE_SYNC1:
+        if (c == UBX_SYNC1) parser->state = UBX_STATE_SYNC2;
+        break;
+
+      case UBX_STATE_SYNC2:
+        if (c != UBX_SYNC2) {
+          // let the caller handle the byte
+          parser->state = UBX_STATE_SYNC1;
+          return i;
+        }
+        parser->ckA = parser->ckB = 0;
+        parser->state = UBX_STATE_CLASS;
+        break;
+
+      case UBX_STATE_CLASS:
+        ubxChecksum(parser->ckA, parser->ckB, c);
+        parser->msgClass = c;
+        parser->state = UBX_STATE_ID;
+        break;
+
+      case UBX_STATE_ID:
+        ubxChecksum(parser->ckA, parser->ckB, c);
+        parser->msgId = c;
+        parser->state = UBX_STATE_LENGTH1;
+        break;
+
+      case UBX_STATE_LENGTH1:
+        ubxChecksum(parser->ckA, parser->ckB, c);
+        parser->length = c;
+        parser->state = UBX_STATE_LENGTH2;
+        break;
+
+      case UBX_STATE_LENGTH2:
+        ubxChecksum(parser->ckA, parser->ckB, c);
+        parser->length |= c << 8;
+        parser->index = 0;
+        parser->state =
+            parser->length > 0 ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A;
+        break;
+
+      case UBX_STATE_PAYLOAD:
+        ubxChecksum(parser->ckA, parser->ckB, c);
+        if (parser->index < UBX_MAX_PAYLOAD) {
+          parser->payload[parser->index] = c;
+        }
+        if (++parser->index >= parser->length) {
+          parser->state = UBX_STATE_CK_A;
+        }
+        break;
+
+      case UBX_STATE_CK_A:
+        if (c != parser->ckA) {
+          parser->state = UBX_STATE_SYNC1;
+          *result = UBX_CHECKSUM_ERROR;
+          return i + 1;
+        }
+        parser->state = UBX_STATE_CK_B;
+        break;
+
+      case UBX_STATE_CK_B:
+        parser->state = UBX_STATE_SYNC1;
+        if (c != parser->ckB) {
+          *result = UBX_CHECKSUM_ERROR;
+        }
+        else if (parser->length <= UBX_MAX_PAYLOAD) {
+          *result = UBX_MESSAGE;
+        }
+        return i + 1;
+    }
+  }
+
+  return len;
+}
+
+bool ubxDecodeNavPvt(const ubx_parser_t* parser, ubx_nav_pvt_t* pvt)
+{
+  if (parser->msgClass != UBX_CLASS_NAV || parser->msgId != UBX_NAV_PVT ||
+      parser->length != UBX_NAV_PVT_LEN) {
+    return false;
+  }
+
+  const uint8_t* p = parser->payload;
+  pvt->year = ubxGetU2(&p[4]);
+  pvt->month = p[6];
+  pvt->day = p[7];
+  pvt->hour = p[8];
+  pvt->min = p[9];
+  pvt->sec = p[10];
+  pvt->valid = p[11];
+  pvt->fixType = p[20];
+  pvt->flags = p[21];
+  pvt->numSV = p[23];
+  pvt->lon = (int32_t)ubxGetU4(&p[24]);
+  pvt->lat = (int32_t)ubxGetU4(&p[28]);
+  pvt->hMSL = (int32_t)ubxGetU4(&p[36]);
+  pvt->gSpeed = (int32_t)ubxGetU4(&p[60]);
+  pvt->headMot = (int32_t)ubxGetU4(&p[64]);
+  pvt->pDOP = ubxGetU2(&p[76]);
+
+  return true;
+}
+
+size_t ubxBuildFrame(uint8_t* frame, uint8_t msgClass, uint8_t msgId,
+                     const uint8_t* payload, uint16_t length)
+{
+  frame[0] = UBX_SYNC1;
+  frame[1] = UBX_SYNC2;
+  frame[2] = msgClass;
+  frame[3] = msgId;
+  frame[4] = length & 0xFF;
+  frame[5] = length >> 8;
+  if (length > 0) {
+    memcpy(&frame[6], payload, length);
+  }
+
+  uint8_t ckA = 0, ckB = 0;
+  for (uint16_t i = 2; i < length + 6; i++) {
+    ubxChecksum(ckA, ckB, frame[i]);
+  }
+  frame[length + 6] = ckA;
+  frame[length + 7] = ckB;
+
+  return length + UBX_FRAME_OVERHEAD;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// u-blox UBX binary protocol decoder
+//
+// The parser does not use any global state, and works on byte
+// spans, so that it can be used on the host as well (tests, fuzzing,
+// parsing of recorded captures).
+
+#define UBX_SYNC1               0xB5
+#define UBX_SYNC2               0x62
+#define UBX_FRAME_OVERHEAD      8 // sync(2) + class + id + length(2) + checksum(2)
+
+#define UBX_CLASS_NAV           0x01
+#define UBX_CLASS_ACK           0x05
+#define UBX_CLASS_CFG           0x06
+
+#define UBX_NAV_PVT             0x07
+#define UBX_CFG_PRT             0x00
+#define UBX_CFG_MSG             0x01
+#define UBX_CFG_RATE            0x08
+
+#define UBX_NAV_PVT_LEN         92
+
+// Longer messages are checked and skipped
+#define UBX_MAX_PAYLOAD         UBX_NAV_PVT_LEN
+
+enum UbxResult {
+  UBX_NONE,           // no complete message yet
+  UBX_MESSAGE,        // complete message available in the parser
+  UBX_CHECKSUM_ERROR, // complete message with bad checksum
+};
+
+struct ubx_parser_t
+{
+  uint8_t state;
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint8_t ckA;
+  uint8_t ckB;
+  uint16_t length;
+  uint16_t index;
+  uint8_t payload[UBX_MAX_PAYLOAD];
+};
+
+// Decoded UBX-NAV-PVT (units as sent by the receiver)
+struct ubx_nav_pvt_t
+{
+  uint16_t year;
+  uint8_t month;
+  uint8_t day;
+  uint8_t hour;
+  uint8_t min;
+  uint8_t sec;
+  uint8_t valid;        // bit 0: date valid, bit 1: time valid
+  uint8_t fixType;      // 0: none, 2: 2D, 3: 3D, ...
+  uint8_t flags;        // bit 0: gnssFixOK
+  uint8_t numSV;
+  int32_t lon;          // degrees * 1e7
+  int32_t lat;          // degrees * 1e7
+  int32_t hMSL;         // mm
+  int32_t gSpeed;       // mm/s
+  int32_t headMot;      // degrees * 1e5
+  uint16_t pDOP;        // * 0.01
+};
+
+void ubxParserInit(ubx_parser_t* parser);
+
+// True while a message is being received
+bool ubxParserBusy(const ubx_parser_t* parser);
+
+// Parse bytes from 'data' until a message is complete, a framing error
+// occurs, or all 'len' bytes are consumed. Bytes outside of a message
+// are skipped. Returns the number of bytes consumed; 'result' tells
+// whether a message is available (class / id / payload in 'parser').
+size_t ubxParse(ubx_parser_t* parser, const uint8_t* data, size_t len,
+                UbxResult* result);
+
+// Decode the last message as NAV-PVT. Returns false if it is not one.
+bool ubxDecodeNavPvt(const ubx_parser_t* parser, ubx_nav_pvt_t* pvt);
+
+// Build a complete UBX frame into 'frame', which must be able to hold
+// 'length' + UBX_FRAME_OVERHEAD bytes. Returns the frame size.
+size_t ubxBuildFrame(uint8_t* frame, uint8_t msgClass, uint8_t msgId,
+                     const uint8_t* payload, uint16_t length);
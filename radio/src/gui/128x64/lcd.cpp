@@ -44,6 +44,29 @@ void lcdClear()
   memset(displayBuf, 0, DISPLAY_BUFFER_SIZE);
 }
 
+uint8_t lcdGetRefreshSpans(pixel_t * shadow, LcdSpan * spans, bool full)
+{
+  uint8_t count = 0;
+  const pixel_t * p = displayBuf;
+
+  for (uint8_t page = 0; page < (LCD_H + 7) / 8; page++, p += LCD_W, shadow += LCD_W) {
+    uint8_t start = 0;
+    uint8_t end = LCD_W;
+    if (!full) {
+      while (start < LCD_W && p[start] == shadow[start])
+        start++;
+      if (start == LCD_W)
+        continue;
+      while (p[end - 1] == shadow[end - 1])
+        end--;
+    }
+    memcpy(shadow + start, p + start, end - start);
+    spans[count++] = {page, start, uint8_t(end - start)};
+  }
+
+  return count;
+}
+
 coord_t lcdLastRightPos;
 coord_t lcdNextPos;
 coord_t lcdLastLeftPos;
@@ -165,6 +165,19 @@ void drawTelemetryTopBar();
 
 
 void lcdClear();
+
+// Columns [start, start+length) of a display page (8 pixel rows)
+struct LcdSpan {
+  uint8_t page;
+  uint8_t start;
+  uint8_t length;
+};
+
+// Copies the parts of displayBuf which differ from 'shadow' into it, and
+// fills 'spans' with them (one span per changed page at most, all the pages
+// when 'full'). Returns the number of spans.
+uint8_t lcdGetRefreshSpans(pixel_t * shadow, LcdSpan * spans, bool full);
+
 void lcdDraw1bitBitmap(coord_t x, coord_t y, const unsigned char * img, uint8_t idx, LcdFlags att=0);
 inline void lcdDrawBitmap(coord_t x, coord_t y, const uint8_t * bitmap)
 {
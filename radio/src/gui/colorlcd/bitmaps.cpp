@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "themes/theme_bitmaps.h"
 
 const uint8_t _LBM_POINT[] = {
 #include "mask_point.lbm"
@@ -246,9 +247,10 @@ struct _BuiltinBitmap {
 
   BitmapFormats  type;
   const uint8_t* lz4_compressed_bitmap;
-  BitmapBuffer** uncompressed_bitmap;
+  BitmapBuffer** theme_bitmap;
 };
 
+// same order as BuiltinBitmap
 static const _BuiltinBitmap _builtinBitmaps[] = {
     {BMP_ARGB4444, stick_pointer, &calibStick},
     {BMP_ARGB4444, stick_background, &calibStickBackground},
@@ -261,7 +263,6 @@ static const _BuiltinBitmap _builtinBitmaps[] = {
 
     {BMP_8BIT, mask_moveback, &modelselModelMoveBackground},
     {BMP_8BIT, mask_moveico, &modelselModelMoveIcon},
-    {BMP_8BIT, mask_moveico, &modelselModelMoveIcon},
 
     {BMP_8BIT, mask_monitor_lockch, &chanMonLockedBitmap},
     {BMP_8BIT, mask_monitor_inver, &chanMonInvertedBitmap},
@@ -270,27 +271,75 @@ static const _BuiltinBitmap _builtinBitmaps[] = {
     {BMP_8BIT, mask_sbar_output, &mixerSetupOutputBitmap},
 
     {BMP_8BIT, mask_textline_label, &mixerSetupLabelIcon},
-    // {BMP_8BIT, mask_textline_curve, &mixerSetupCurveIcon},
     {BMP_8BIT, mask_textline_switch, &mixerSetupSwitchIcon},
     {BMP_8BIT, mask_textline_slow, &mixerSetupSlowIcon},
     {BMP_8BIT, mask_textline_delay, &mixerSetupDelayIcon},
     {BMP_8BIT, mask_textline_delayslow, &mixerSetupDelaySlowIcon},
 };
 
-void loadBuiltinBitmaps()
+static_assert(DIM(_builtinBitmaps) == BUILTIN_BITMAPS_COUNT,
+              "BuiltinBitmap and _builtinBitmaps mismatch");
+
+class BuiltinBitmapCache : public LazyBitmapCache<BUILTIN_BITMAPS_COUNT>
 {
-  for (const auto& bm : _builtinBitmaps) {
+ public:
+  BuiltinBitmapCache() : LazyBitmapCache(BUILTIN_BITMAPS_CACHE_SIZE) {}
+
+  const BitmapBuffer* get(unsigned index)
+  {
+    if (!bitmaps[index]) {
+      const _BuiltinBitmap& bm = _builtinBitmaps[index];
+      BitmapBuffer* bitmap = nullptr;
+      size_t bpp = 1;
+      if (bm.type == BMP_ARGB4444 || bm.type == BMP_RGB565) {
+        bitmap = new LZ4Bitmap(bm.type, bm.lz4_compressed_bitmap);
+        bpp = 2;
+      } else if (bm.type == BMP_8BIT) {
+        bitmap = BitmapBuffer::load8bitMaskLZ4(bm.lz4_compressed_bitmap);
+      }
+      if (!bitmap) return nullptr;
 
-    delete *bm.uncompressed_bitmap;
-    *bm.uncompressed_bitmap = nullptr;
-    
-    if (bm.type == BMP_ARGB4444 ||
-        bm.type == BMP_RGB565) {
-      *bm.uncompressed_bitmap = new LZ4Bitmap(bm.type, bm.lz4_compressed_bitmap);
-    } else if (bm.type == BMP_8BIT) {
-      *bm.uncompressed_bitmap = BitmapBuffer::load8bitMaskLZ4(bm.lz4_compressed_bitmap);
+      bitmaps[index] = bitmap;
+      loaded(index, bitmap->width() * bitmap->height() * bpp);
+    } else {
+      touch(index);
     }
+    return bitmaps[index];
+  }
+
+ protected:
+  BitmapBuffer* bitmaps[BUILTIN_BITMAPS_COUNT] = {nullptr};
+
+  void unload(unsigned index) override
+  {
+    delete bitmaps[index];
+    bitmaps[index] = nullptr;
+  }
+};
+
+static BuiltinBitmapCache _builtinBitmapCache;
+
+const BitmapBuffer* getBuiltinBitmap(BuiltinBitmap id)
+{
+  BitmapBuffer* themeBitmap = *_builtinBitmaps[id].theme_bitmap;
+  if (themeBitmap) return themeBitmap;
+  return _builtinBitmapCache.get(id);
+}
+
+size_t getBuiltinBitmapsMemory()
+{
+  return _builtinBitmapCache.memoryUsed();
+}
+
+void loadBuiltinBitmaps()
+{
+  // the overrides belong to the theme being replaced
+  for (const auto& bm : _builtinBitmaps) {
+    delete *bm.theme_bitmap;
+    *bm.theme_bitmap = nullptr;
   }
+
+  _builtinBitmapCache.unloadAll();
 }
 
 struct _BuiltinIcon {
@@ -26,40 +26,100 @@
 
 DEFINE_LZ4_BITMAP(LBM_POINT);
 
-// Model selection bitmaps
-extern BitmapBuffer * modelselSdFreeBitmap;
-extern BitmapBuffer * modelselModelQtyBitmap;
-extern BitmapBuffer * modelselModelNameBitmap;
-extern BitmapBuffer * modelselModelMoveBackground;
-extern BitmapBuffer * modelselModelMoveIcon;
-extern BitmapBuffer * modelselWizardBackground;
-
-// calibration bitmaps
-extern BitmapBuffer * calibStick;
-extern BitmapBuffer * calibStickBackground;
-extern BitmapBuffer * calibTrackpBackground;
-
-// Channels monitor bitmaps
-extern BitmapBuffer * chanMonLockedBitmap;
-extern BitmapBuffer * chanMonInvertedBitmap;
-
-// Mixer setup bitmaps
-extern BitmapBuffer * mixerSetupMixerBitmap;
-extern BitmapBuffer * mixerSetupToBitmap;
-extern BitmapBuffer * mixerSetupOutputBitmap;
-extern BitmapBuffer * mixerSetupAddBitmap;
-extern BitmapBuffer * mixerSetupMultiBitmap;
-extern BitmapBuffer * mixerSetupReplaceBitmap;
-extern BitmapBuffer * mixerSetupLabelIcon;
-extern BitmapBuffer * mixerSetupCurveIcon;
-extern BitmapBuffer * mixerSetupSwitchIcon;
-extern BitmapBuffer * mixerSetupDelayIcon;
-extern BitmapBuffer * mixerSetupSlowIcon;
-extern BitmapBuffer * mixerSetupDelaySlowIcon;
+enum BuiltinBitmap {
+  BITMAP_CALIB_STICK,
+  BITMAP_CALIB_STICK_BACKGROUND,
+  BITMAP_CALIB_TRACKP_BACKGROUND,
+  BITMAP_MODELSEL_SDFREE,
+  BITMAP_MODELSEL_MODELQTY,
+  BITMAP_MODELSEL_MODELNAME,
+  BITMAP_MODELSEL_MOVE_BACKGROUND,
+  BITMAP_MODELSEL_MOVE_ICON,
+  BITMAP_CHANMON_LOCKED,
+  BITMAP_CHANMON_INVERTED,
+  BITMAP_MIXER_SETUP_MIXER,
+  BITMAP_MIXER_SETUP_OUTPUT,
+  BITMAP_MIXER_SETUP_LABEL,
+  BITMAP_MIXER_SETUP_SWITCH,
+  BITMAP_MIXER_SETUP_SLOW,
+  BITMAP_MIXER_SETUP_DELAY,
+  BITMAP_MIXER_SETUP_DELAYSLOW,
+  BUILTIN_BITMAPS_COUNT
+};
 
+// Memory used by the decompressed builtin bitmaps
+#define BUILTIN_BITMAPS_CACHE_SIZE  (64 * 1024)
+
+// Builtin bitmaps are decompressed on first use, the returned bitmap
+// may be unloaded by the next call: draw it right away, do not keep it.
+// A theme may provide its own bitmap by setting the matching pointer
+// declared in themes/theme_bitmaps.h, which is then used instead.
+const BitmapBuffer* getBuiltinBitmap(BuiltinBitmap id);
+size_t getBuiltinBitmapsMemory();
+
+// Unloads the builtin bitmaps, they will be decompressed again when used.
+// The theme overrides are deleted: a theme sets them after this call.
 void loadBuiltinBitmaps();
 const uint8_t* getBuiltinIcon(MenuIcons id);
 
+// Bitmaps loaded on first use and unloaded in least recently used order
+// once the memory they take exceeds the budget. Pinned entries are never
+// unloaded, except by unloadAll().
+template <unsigned N>
+class LazyBitmapCache
+{
+ public:
+  explicit LazyBitmapCache(size_t budget) : budget(budget) {}
+
+  size_t memoryUsed() const { return used; }
+  bool isLoaded(unsigned index) const { return sizes[index] != 0; }
+  void pin(unsigned index) { pinned[index] = true; }
+
+  void unloadAll()
+  {
+    for (unsigned i = 0; i < N; i++) {
+      if (sizes[i]) remove(i);
+    }
+  }
+
+ protected:
+  size_t budget;
+  size_t used = 0;
+  uint32_t clock = 0;
+  uint32_t lastUse[N] = {0};
+  uint32_t sizes[N] = {0};
+  bool pinned[N] = {false};
+
+  virtual void unload(unsigned index) = 0;
+
+  void touch(unsigned index) { lastUse[index] = ++clock; }
+
+  // to be called once an entry has been loaded, makes room for it
+  void loaded(unsigned index, size_t size)
+  {
+    sizes[index] = size;
+    used += size;
+    touch(index);
+
+    while (used > budget) {
+      unsigned victim = N;
+      for (unsigned i = 0; i < N; i++) {
+        if (i == index || pinned[i] || !sizes[i]) continue;
+        if (victim == N || lastUse[i] < lastUse[victim]) victim = i;
+      }
+      if (victim == N) break;
+      remove(victim);
+    }
+  }
+
+  void remove(unsigned index)
+  {
+    unload(index);
+    used -= sizes[index];
+    sizes[index] = 0;
+  }
+};
+
 PACK(struct _bitmap_mask {
   uint16_t w;
   uint16_t h;
@@ -132,13 +132,13 @@ class ComboChannelBar : public Window
       // Override icon
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
       if (safetyCh[channel] != OVERRIDE_CHANNEL_UNDEFINED)
-        dc->drawMask(0, 1, chanMonLockedBitmap, textColor);
+        dc->drawMask(0, 1, getBuiltinBitmap(BITMAP_CHANMON_LOCKED), textColor);
 #endif
 
       // Channel reverted icon
       LimitData * ld = limitAddress(channel);
       if (ld && ld->revert) {
-        dc->drawMask(0, 20, chanMonInvertedBitmap, textColor);
+        dc->drawMask(0, 20, getBuiltinBitmap(BITMAP_CHANMON_INVERTED), textColor);
       }
     }
 
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include "model_select.h"
+#include "model_thumbnails.h"
 #include "opentx.h"
 #include "storage/modelslist.h"
 #include "libopenui.h"
@@ -44,6 +45,22 @@ constexpr size_t LEN_PATH = sizeof(TEMPLATES_PATH) + TEXT_FILENAME_MAXLEN;
 constexpr size_t LEN_BUFFER = sizeof(TEMPLATES_PATH) + 2 * TEXT_FILENAME_MAXLEN + 1;
 inline tmr10ms_t getTicks() { return g_tmr10ms; }
 
+// Models are read and their thumbnails loaded from the SD card only once
+// their button is drawn, within this time budget per refresh, so that
+// the model selector opens immediately even with many models.
+constexpr uint32_t MODEL_LOAD_BUDGET_MS = 15;
+static uint32_t modelLoadDeadline = 0;
+
+static bool modelLoadAllowed()
+{
+  return (int32_t)(modelLoadDeadline - RTOS_GET_MS()) > 0;
+}
+
+// two screens worth of cells
+static ThumbnailCache modelThumbnails(
+    MODEL_SELECT_CELL_WIDTH, MODEL_SELECT_CELL_HEIGHT,
+    2 * (LCD_H / MODEL_SELECT_CELL_HEIGHT + 1) * MODEL_CELLS_PER_LINE);
+
 class TemplatePage : public Page
 {
   public:
@@ -323,15 +340,8 @@ class ModelButton : public Button
   {
     setWidth(MODEL_SELECT_CELL_WIDTH);
     setHeight(MODEL_SELECT_CELL_HEIGHT);
-
-    load();
   }
 
-  ~ModelButton()
-  {
-    if (buffer) { delete buffer; }
-  }
-  
   void load()
   {
 #if defined(SDCARD_RAW)
@@ -382,28 +392,20 @@ class ModelButton : public Button
 #endif
         modelCell->setModelName(partialModel.header.name);
       }
+      strAppend(bitmap, partialModel.header.bitmap, LEN_BITMAP_NAME);
     }
 
-    delete buffer;
-    buffer = new BitmapBuffer(BMP_RGB565, width(), height());
-    if (buffer == nullptr) {
-      return;
-    }
-    buffer->clear(COLOR_THEME_PRIMARY2);
+    loaded = true;
+    invalid = (error != nullptr);
+  }
 
-    if (error) {
-      buffer->drawText(width() / 2, 2, "(Invalid Model)",
-                       COLOR_THEME_SECONDARY1 | CENTERED);
-    } else {
-      GET_FILENAME(filename, BITMAPS_PATH, partialModel.header.bitmap, "");
-      const BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(filename);
-      if (bitmap) {
-        buffer->drawScaledBitmap(bitmap, 0, 0, width(), height());
-        delete bitmap;
-      } else {
-        buffer->drawText(width() / 2, 56, "(No Picture)",
-                         FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
-      }
+  void checkEvents() override
+  {
+    Button::checkEvents();
+
+    if (loadRequested && !loaded && modelLoadAllowed()) {
+      load();
+      invalidate();
     }
   }
 
@@ -411,8 +413,29 @@ class ModelButton : public Button
   {
     FormField::paint(dc);
 
-    if (buffer)
-      dc->drawBitmap(0, 0, buffer);
+    dc->drawSolidFilledRect(0, 0, width(), height(), COLOR_THEME_PRIMARY2);
+
+    if (!loaded) {
+      // read on the next refresh
+      loadRequested = true;
+    } else if (invalid) {
+      dc->drawText(width() / 2, 2, "(Invalid Model)",
+                   COLOR_THEME_SECONDARY1 | CENTERED);
+    } else {
+      const BitmapBuffer *thumbnail = nullptr;
+      switch (modelThumbnails.get(bitmap, thumbnail)) {
+        case ThumbnailCache::THUMBNAIL_READY:
+          dc->drawBitmap((width() - thumbnail->width()) / 2,
+                         (height() - thumbnail->height()) / 2, thumbnail);
+          break;
+        case ThumbnailCache::THUMBNAIL_MISSING:
+          dc->drawText(width() / 2, 56, "(No Picture)",
+                       FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
+          break;
+        case ThumbnailCache::THUMBNAIL_LOADING:
+          break;
+      }
+    }
 
     if (modelCell == modelslist.getCurrentModel()) {
       dc->drawSolidFilledRect(0, 0, width(), 20, COLOR_THEME_ACTIVE);
@@ -447,7 +470,10 @@ class ModelButton : public Button
 
  protected:
   ModelCell *modelCell;
-  BitmapBuffer *buffer = nullptr;
+  char bitmap[LEN_BITMAP_NAME + 1] = {0};
+  bool loaded = false;
+  bool loadRequested = false;
+  bool invalid = false;
 };
 
 static void _saveTemplate(ModelCell* model)
@@ -484,6 +510,17 @@ class ModelCategoryPageBody : public FormWindow
       addModelButton(model);
   }
 
+  void checkEvents() override
+  {
+    modelLoadDeadline = RTOS_GET_MS() + MODEL_LOAD_BUDGET_MS;
+    FormWindow::checkEvents();
+
+    // thumbnails requested by the buttons drawn so far
+    while (modelLoadAllowed() && modelThumbnails.process()) {
+      invalidate();
+    }
+  }
+
  protected:
   ModelsCategory *category;
 
@@ -750,6 +787,11 @@ ModelSelectMenu::ModelSelectMenu():
   build();
 }
 
+ModelSelectMenu::~ModelSelectMenu()
+{
+  modelThumbnails.clear();
+}
+
 void ModelSelectMenu::build(int index) 
 {  
   modelslist.clear();
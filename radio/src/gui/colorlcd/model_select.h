@@ -27,6 +27,7 @@
 class ModelSelectMenu: public TabsGroup {
   public:
     ModelSelectMenu();
+    ~ModelSelectMenu();
     void build(int index=-1);
 };
 
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include "model_thumbnails.h"
+#include "opentx.h"
+#include "libopenui.h"
+
+#define THUMBNAIL_MAGIC  0x31425448  // "THB1"
+#define THUMBNAIL_EXT    ".thb"
+
+PACK(struct ThumbnailHeader {
+  uint32_t magic;
+  uint16_t boxWidth;
+  uint16_t boxHeight;
+  uint32_t sourceSize;
+  uint16_t sourceDate;
+  uint16_t sourceTime;
+  uint16_t width;
+  uint16_t height;
+});
+
+static BitmapBuffer* loadThumbnail(const char* path,
+                                   const ThumbnailHeader& expected)
+{
+  FIL file;
+  if (f_open(&file, path, FA_READ) != FR_OK) return nullptr;
+
+  BitmapBuffer* bitmap = nullptr;
+  ThumbnailHeader header;
+  UINT read;
+
+  if (f_read(&file, &header, sizeof(header), &read) == FR_OK &&
+      read == sizeof(header) && header.magic == expected.magic &&
+      header.boxWidth == expected.boxWidth &&
+      header.boxHeight == expected.boxHeight &&
+      header.sourceSize == expected.sourceSize &&
+      header.sourceDate == expected.sourceDate &&
+      header.sourceTime == expected.sourceTime && header.width > 0 &&
+      header.width <= expected.boxWidth && header.height > 0 &&
+      header.height <= expected.boxHeight) {
+    bitmap = new BitmapBuffer(BMP_RGB565, header.width, header.height);
+    UINT size = header.width * header.height * sizeof(uint16_t);
+    if (f_read(&file, bitmap->getData(), size, &read) != FR_OK ||
+        read != size) {
+      delete bitmap;
+      bitmap = nullptr;
+    }
+  }
+
+  f_close(&file);
+  return bitmap;
+}
+
+static void saveThumbnail(const char* path, const ThumbnailHeader& header,
+                          BitmapBuffer* bitmap)
+{
+  if (sdCheckAndCreateDirectory(THUMBNAILS_PATH)) return;
+
+  FIL file;
+  if (f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) return;
+
+  UINT size = header.width * header.height * sizeof(uint16_t);
+  UINT written;
+  bool ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+            written == sizeof(header) &&
+            f_write(&file, bitmap->getData(), size, &written) == FR_OK &&
+            written == size;
+  f_close(&file);
+
+  if (!ok) {
+    TRACE("Could not write thumbnail %s", path);
+    f_unlink(path);
+  }
+}
+
+ThumbnailCache::ThumbnailCache(uint16_t width, uint16_t height,
+                               size_t capacity) :
+    width(width), height(height), capacity(capacity)
+{
+}
+
+ThumbnailCache::~ThumbnailCache() { clear(); }
+
+void ThumbnailCache::clear()
+{
+  for (auto& entry : entries) {
+    delete entry.bitmap;
+  }
+  entries.clear();
+  requests.clear();
+}
+
+ThumbnailCache::State ThumbnailCache::get(const char* name,
+                                          const BitmapBuffer*& bitmap)
+{
+  bitmap = nullptr;
+  if (name[0] == '\0') return THUMBNAIL_MISSING;
+
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (it->name == name) {
+      entries.splice(entries.begin(), entries, it);
+      bitmap = it->bitmap;
+      return bitmap ? THUMBNAIL_READY : THUMBNAIL_MISSING;
+    }
+  }
+
+  // the most recent requests are the ones on screen, serve them first
+  auto it = std::find(requests.begin(), requests.end(), name);
+  if (it != requests.end()) {
+    requests.splice(requests.begin(), requests, it);
+  } else {
+    requests.emplace_front(name);
+    if (requests.size() > capacity) requests.pop_back();
+  }
+
+  return THUMBNAIL_LOADING;
+}
+
+bool ThumbnailCache::process()
+{
+  if (requests.empty()) return false;
+
+  std::string name = requests.front();
+  requests.pop_front();
+
+  entries.push_front({name, load(name.c_str())});
+  while (entries.size() > capacity) {
+    delete entries.back().bitmap;
+    entries.pop_back();
+  }
+
+  return true;
+}
+
+BitmapBuffer* ThumbnailCache::load(const char* name)
+{
+  char path[FF_MAX_LFN + 1];
+  snprintf(path, sizeof(path), "%s/%s", BITMAPS_PATH, name);
+
+  FILINFO info;
+  if (f_stat(path, &info) != FR_OK) return nullptr;
+
+  ThumbnailHeader header = {THUMBNAIL_MAGIC, width,        height,
+                            (uint32_t)info.fsize, info.fdate, info.ftime,
+                            0, 0};
+
+  char thumbnailPath[FF_MAX_LFN + 1];
+  snprintf(thumbnailPath, sizeof(thumbnailPath), "%s/%s%s", THUMBNAILS_PATH,
+           name, THUMBNAIL_EXT);
+
+  BitmapBuffer* bitmap = loadThumbnail(thumbnailPath, header);
+  if (bitmap) return bitmap;
+
+  TRACE("Building thumbnail for %s", path);
+  BitmapBuffer* source = BitmapBuffer::loadBitmap(path);
+  if (!source) return nullptr;
+
+  // keep the aspect ratio, the thumbnail is centered in its box when drawn
+  uint32_t w = width;
+  uint32_t h = source->height() * width / source->width();
+  if (h > height) {
+    h = height;
+    w = source->width() * height / source->height();
+  }
+  header.width = std::max<uint32_t>(w, 1);
+  header.height = std::max<uint32_t>(h, 1);
+
+  bitmap = new BitmapBuffer(BMP_RGB565, header.width, header.height);
+  bitmap->drawScaledBitmap(source, 0, 0, header.width, header.height);
+  delete source;
+
+  saveThumbnail(thumbnailPath, header, bitmap);
+  return bitmap;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+#include "sdcard.h"
+
+#define THUMBNAILS_PATH  BITMAPS_PATH PATH_SEPARATOR ".thumbs"
+
+class BitmapBuffer;
+
+// Model bitmaps scaled down to fit a box of a given size.
+//
+// Scaled thumbnails are stored as raw RGB565 files in THUMBNAILS_PATH,
+// together with the size and modification time of their source bitmap,
+// so that an image is only decoded and scaled again when it changed.
+// The most recently used thumbnails are kept in RAM.
+//
+// Nothing is loaded by get(): requests are queued and served one at a time
+// by process(), newest first, so that the caller can spread the SD card
+// accesses over several refreshes.
+class ThumbnailCache
+{
+ public:
+  enum State {
+    THUMBNAIL_LOADING,
+    THUMBNAIL_READY,
+    THUMBNAIL_MISSING,
+  };
+
+  ThumbnailCache(uint16_t width, uint16_t height, size_t capacity);
+  ~ThumbnailCache();
+
+  State get(const char* name, const BitmapBuffer*& bitmap);
+
+  // Returns true if a request was served
+  bool process();
+
+  void clear();
+
+ protected:
+  struct Entry {
+    std::string name;
+    BitmapBuffer* bitmap;
+  };
+
+  uint16_t width;
+  uint16_t height;
+  size_t capacity;
+  std::list<Entry> entries;       // most recently used first
+  std::list<std::string> requests;  // most recent first
+
+  BitmapBuffer* load(const char* name);
+};
@@ -36,20 +36,21 @@ class StickCalibrationWindow: public Window {
                           uint8_t stickY) :
        Window(parent, rect, REFRESH_ALWAYS), stickX(stickX), stickY(stickY)
    {
-     setLeft(rect.x - calibStickBackground->width() / 2);
-     setTop(rect.y - calibStickBackground->height() / 2);
-     setWidth(calibStickBackground->width());
-     setHeight(calibStickBackground->height());
+     auto background = getBuiltinBitmap(BITMAP_CALIB_STICK_BACKGROUND);
+     setLeft(rect.x - background->width() / 2);
+     setTop(rect.y - background->height() / 2);
+     setWidth(background->width());
+     setHeight(background->height());
     }
 
     void paint(BitmapBuffer * dc) override
     {
-      dc->drawBitmap(0, 0, calibStickBackground);
+      dc->drawBitmap(0, 0, getBuiltinBitmap(BITMAP_CALIB_STICK_BACKGROUND));
       int16_t x = calibratedAnalogs[CONVERT_MODE(stickX)];
       int16_t y = calibratedAnalogs[CONVERT_MODE(stickY)];
       dc->drawBitmap(width() / 2 - 9 + (bitmapSize / 2 * x) / RESX,
                      height() / 2 - 9 - (bitmapSize / 2 * y) / RESX,
-                     calibStick);
+                     getBuiltinBitmap(BITMAP_CALIB_STICK));
     }
 
   protected:
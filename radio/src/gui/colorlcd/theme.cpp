@@ -184,6 +184,11 @@ void OpenTxTheme::drawUsbPluggedScreen(BitmapBuffer * dc) const
 }
 
 
+size_t OpenTxTheme::getBitmapsMemory() const
+{
+  return getBuiltinBitmapsMemory();
+}
+
 OpenTxTheme * getTheme(const char * name)
 {
   std::list<OpenTxTheme *>::const_iterator it = getRegisteredThemes().cbegin();
@@ -198,8 +203,11 @@ OpenTxTheme * getTheme(const char * name)
 void loadTheme(OpenTxTheme * newTheme)
 {
   TRACE("load theme %s", newTheme->getName());
+  uint32_t start = RTOS_GET_MS();
   theme = newTheme;
   newTheme->load();
+  TRACE("theme loaded in %d ms, %d bytes of bitmaps",
+        RTOS_GET_MS() - start, newTheme->getBitmapsMemory());
 }
 
 void loadTheme()
@@ -110,6 +110,9 @@ class OpenTxTheme: public Theme
 
     virtual void drawUsbPluggedScreen(BitmapBuffer * dc) const;
 
+    // memory used by the decompressed icons and bitmaps
+    virtual size_t getBitmapsMemory() const;
+
   
   protected:
     const char * name;
@@ -46,6 +46,85 @@ const uint8_t mask_currentmenu_shadow[] = {
 #include "mask_currentmenu_shadow.lbm"
 };
 
+// Memory used by the decompressed menu icons
+constexpr size_t MENU_ICONS_CACHE_SIZE = 64 * 1024;
+
+// Icons always kept loaded, as shown on the main view
+static const MenuIcons mainViewIcons[] = {
+  ICON_OPENTX,
+};
+
+// Menu icons are decompressed and drawn with the theme colors on first use
+class MenuIconCache: public LazyBitmapCache<MENUS_ICONS_COUNT>
+{
+  public:
+    MenuIconCache():
+      LazyBitmapCache(MENU_ICONS_CACHE_SIZE)
+    {
+    }
+
+    const BitmapBuffer * getMask(uint8_t index)
+    {
+      load(index);
+      return masks[index];
+    }
+
+    const BitmapBuffer * getIcon(uint8_t index, IconState state)
+    {
+      load(index);
+      return state == STATE_DEFAULT ? normal[index] : selected[index];
+    }
+
+    void recolorAll()
+    {
+      for (unsigned i = 0; i < MENUS_ICONS_COUNT; i++) {
+        if (masks[i]) recolor(i);
+      }
+    }
+
+  protected:
+    BitmapBuffer * masks[MENUS_ICONS_COUNT] = { nullptr };
+    BitmapBuffer * normal[MENUS_ICONS_COUNT] = { nullptr };
+    BitmapBuffer * selected[MENUS_ICONS_COUNT] = { nullptr };
+
+    void load(uint8_t index)
+    {
+      if (masks[index]) {
+        touch(index);
+        return;
+      }
+
+      BitmapBuffer * mask = BitmapBuffer::load8bitMaskLZ4(getBuiltinIcon((MenuIcons)index));
+      if (!mask) return;
+
+      masks[index] = mask;
+      normal[index] = new BitmapBuffer(BMP_RGB565, mask->width(), mask->height());
+      selected[index] = new BitmapBuffer(BMP_RGB565, mask->width(), mask->height());
+      recolor(index);
+
+      // 8 bit mask + 2 RGB565 bitmaps
+      loaded(index, mask->width() * mask->height() * 5);
+    }
+
+    void recolor(uint8_t index)
+    {
+      normal[index]->clear(COLOR_THEME_SECONDARY1);
+      normal[index]->drawMask(0, 0, masks[index], COLOR_THEME_PRIMARY2);
+      selected[index]->clear(COLOR_THEME_FOCUS);
+      selected[index]->drawMask(0, 0, masks[index], COLOR_THEME_PRIMARY2);
+    }
+
+    void unload(unsigned index) override
+    {
+      delete masks[index];
+      masks[index] = nullptr;
+      delete normal[index];
+      normal[index] = nullptr;
+      delete selected[index];
+      selected[index] = nullptr;
+    }
+};
+
 class Theme480: public OpenTxTheme
 {
   public:
@@ -75,41 +154,16 @@ class Theme480: public OpenTxTheme
       lcdColorTable[CUSTOM_COLOR_INDEX] = RGB(170, 85, 0);
     }
 
-    void loadMenuIcon(uint8_t index, const uint8_t * lbm, bool reload) const
+    void loadIcons(bool reload) const
     {
-      BitmapBuffer * mask;
-      
       if (reload) {
-        mask = BitmapBuffer::load8bitMaskLZ4(lbm);
-        if (mask) {
-          delete iconMask[index];
-          iconMask[index] = mask;
-
-          delete menuIconNormal[index];
-          menuIconNormal[index] = new BitmapBuffer(BMP_RGB565, mask->width(), mask->height());
-
-          delete menuIconSelected[index];
-          menuIconSelected[index] = new BitmapBuffer(BMP_RGB565, mask->width(), mask->height());
+        menuIcons.unloadAll();
+        for (auto icon : mainViewIcons) {
+          menuIcons.pin(icon);
+          menuIcons.getMask(icon);
         }
-      } else
-        mask = iconMask[index];
-      
-      if (menuIconNormal[index]) {
-        menuIconNormal[index]->clear(COLOR_THEME_SECONDARY1);
-        menuIconNormal[index]->drawMask(0, 0, mask, COLOR_THEME_PRIMARY2);
-      }
-  
-      if (menuIconSelected[index]) {
-        menuIconSelected[index]->clear(COLOR_THEME_FOCUS);
-        menuIconSelected[index]->drawMask(0, 0, mask, COLOR_THEME_PRIMARY2);
-      }
-    }
-
-    void loadIcons(bool reload) const
-    {
-      for (int id = ICON_OPENTX; id != MENUS_ICONS_COUNT; id++) {
-        MenuIcons icon_id = (MenuIcons)id;
-        loadMenuIcon(icon_id, getBuiltinIcon(icon_id), reload);
+      } else {
+        menuIcons.recolorAll();
       }
 
       unique_ptr<BitmapBuffer> background(BitmapBuffer::load8bitMaskLZ4(mask_currentmenu_bg));
@@ -194,7 +248,7 @@ class Theme480: public OpenTxTheme
     {
       if (topleftBitmap) {
         dc->drawBitmap(0, 0, topleftBitmap);
-        dc->drawBitmap(4, 10, menuIconSelected[ICON_OPENTX]);
+        dc->drawBitmap(4, 10, menuIcons.getIcon(ICON_OPENTX, STATE_PRESSED));
       }
     }
 
@@ -211,9 +265,9 @@ class Theme480: public OpenTxTheme
       }
 
       if (icon == ICON_OPENTX)
-        dc->drawBitmap(4, 10, menuIconSelected[ICON_OPENTX]);
+        dc->drawBitmap(4, 10, menuIcons.getIcon(ICON_OPENTX, STATE_PRESSED));
       else
-        dc->drawBitmap(5, 7, menuIconSelected[icon]);
+        dc->drawBitmap(5, 7, menuIcons.getIcon(icon, STATE_PRESSED));
 
       dc->drawSolidFilledRect(0, MENU_HEADER_HEIGHT, LCD_W,
                               MENU_TITLE_TOP - MENU_HEADER_HEIGHT,
@@ -230,12 +284,17 @@ class Theme480: public OpenTxTheme
 
     const BitmapBuffer * getIconMask(uint8_t index) const override
     {
-      return iconMask[index];
+      return menuIcons.getMask(index);
     }
 
     const BitmapBuffer * getIcon(uint8_t index, IconState state) const override
     {
-      return state == STATE_DEFAULT ? menuIconNormal[index] : menuIconSelected[index];
+      return menuIcons.getIcon(index, state);
+    }
+
+    size_t getBitmapsMemory() const override
+    {
+      return menuIcons.memoryUsed() + getBuiltinBitmapsMemory();
     }
 
     void drawCurrentMenuBackground(BitmapBuffer *dc) const override
@@ -275,17 +334,13 @@ class Theme480: public OpenTxTheme
   protected:
     static const BitmapBuffer * backgroundBitmap;
     static BitmapBuffer * topleftBitmap;
-    static BitmapBuffer * menuIconNormal[MENUS_ICONS_COUNT];
-    static BitmapBuffer * menuIconSelected[MENUS_ICONS_COUNT];
-    static BitmapBuffer * iconMask[MENUS_ICONS_COUNT];
+    static MenuIconCache menuIcons;
     static BitmapBuffer * currentMenuBackground;
 };
 
 const BitmapBuffer * Theme480::backgroundBitmap = nullptr;
 BitmapBuffer * Theme480::topleftBitmap = nullptr;
-BitmapBuffer * Theme480::iconMask[MENUS_ICONS_COUNT] = { nullptr };
-BitmapBuffer * Theme480::menuIconNormal[MENUS_ICONS_COUNT] = { nullptr };
-BitmapBuffer * Theme480::menuIconSelected[MENUS_ICONS_COUNT] = { nullptr };
+MenuIconCache Theme480::menuIcons;
 BitmapBuffer * Theme480::currentMenuBackground = nullptr;
 
 Theme480 Theme480;
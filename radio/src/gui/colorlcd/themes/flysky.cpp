@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "tabsgroup.h"
+#include "theme_bitmaps.h"
 
 const ZoneOption OPTIONS_THEME_DEFAULT[] = {
   { STR_BACKGROUND_COLOR, ZoneOption::Color, OPTION_VALUE_UNSIGNED(COLOR_THEME_PRIMARY2) },
@@ -37,6 +37,38 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+// Value of each GVar in each flight mode, once the flight modes links are
+// resolved, and the flight modes values they were resolved from
+static int16_t gvarsResolved[MAX_FLIGHT_MODES][MAX_GVARS];
+static gvar_t gvarsResolvedFrom[MAX_FLIGHT_MODES][MAX_GVARS];
+static bool gvarsResolvedValid = false;
+
+static void resolveGVars()
+{
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    memcpy(gvarsResolvedFrom[fm], g_model.flightModeData[fm].gvars, sizeof(gvarsResolvedFrom[fm]));
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      gvarsResolved[fm][gv] = GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
+    }
+  }
+  gvarsResolvedValid = true;
+}
+
+void invalidateGVars()
+{
+  gvarsResolvedValid = false;
+}
+
+void checkGVars()
+{
+  // the GVars may be written directly (menus, Lua, model load)
+  for (uint8_t fm = 0; gvarsResolvedValid && fm < MAX_FLIGHT_MODES; fm++) {
+    if (memcmp(gvarsResolvedFrom[fm], g_model.flightModeData[fm].gvars, sizeof(gvarsResolvedFrom[fm]))) {
+      gvarsResolvedValid = false;
+    }
+  }
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
@@ -44,7 +76,10 @@ int16_t getGVarValue(int8_t gv, int8_t fm)
     gv = -1-gv;
     mul = -1;
   }
-  return GVAR_VALUE(gv, getGVarFlightMode(fm, gv)) * mul;
+  if (!gvarsResolvedValid) {
+    resolveGVars();
+  }
+  return gvarsResolved[fm][gv] * mul;
 }
 
 int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
@@ -54,7 +89,10 @@ int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
   if (gv < 0) {
     mul = -mul;
   }
-  return GVAR_VALUE(idx, getGVarFlightMode(fm, idx)) * mul;
+  if (!gvarsResolvedValid) {
+    resolveGVars();
+  }
+  return gvarsResolved[fm][idx] * mul;
 }
 
 void setGVarValue(uint8_t gv, int16_t value, int8_t fm)
@@ -26,6 +26,7 @@
   #define GVAR_VALUE(gv, fm)           g_model.flightModeData[fm].gvars[gv]
   #define SET_GVAR_VALUE(idx, phase, value) \
     GVAR_VALUE(idx, phase) = value; \
+    invalidateGVars(); \
     storageDirty(EE_MODEL); \
     if (g_model.gvars[idx].popup) { \
       gvarLastChanged = idx; \
@@ -39,6 +40,10 @@
     int16_t getGVarValue(int8_t gv, int8_t fm);
     int32_t getGVarValuePrec1(int8_t gv, int8_t fm);
     void setGVarValue(uint8_t x, int16_t value, int8_t fm);
+    // the values above are resolved once for all the flight modes, again after
+    // SET_GVAR_VALUE() or when checkGVars() finds them modified
+    void invalidateGVars();
+    void checkGVars();
     #define GET_GVAR(x, min, max, fm)  getGVarFieldValue(x, min, max, fm)
     #define SET_GVAR(idx, val, fm)     setGVarValue(idx, val, fm)
     #define GVAR_DISPLAY_TIME          100 /*1 second*/;
@@ -53,6 +53,7 @@ struct etx_serial_callbacks_t {
   uint8_t (*on_send)(uint8_t* data);
   void (*on_receive)(uint8_t data);
   void (*on_error)();
+  void (*on_idle)();
 };
 
 typedef struct {
@@ -85,4 +86,8 @@ typedef struct {
   void (*setReceiveCb)(void* ctx, void (*on_receive)(uint8_t*, uint32_t));
   void (*setBaudrateCb)(void* ctx, void (*on_set_baudrate)(uint32_t));
 
+  //  - setIdleCb: 'on_idle' is called when the line goes idle
+  //    after some data has been received (end of frame)
+  void (*setIdleCb)(void* ctx, void (*on_idle)());
+
 } etx_serial_driver_t;
@@ -88,7 +88,7 @@ void FrskyDeviceFirmwareUpdate::processFrame(const uint8_t * frame)
       case PRIM_ACK_VERSION:
         if (state == SPORT_VERSION_REQ) {
           state = SPORT_VERSION_ACK;
-          // here we could display the version
+          bootloaderVersion = *((uint32_t *)(&frame[3]));
         }
         break;
 
@@ -207,9 +207,13 @@ const uint8_t * FrskyDeviceFirmwareUpdate::readFrame(uint32_t timeout)
 
 bool FrskyDeviceFirmwareUpdate::waitState(State newState, uint32_t timeout)
 {
-#if defined(SIMU)
-  UNUSED(state);
+#if defined(SIMU) && !defined(GTESTS)
   UNUSED(timeout);
+  // behave as a device requesting the words one after the other
+  if (newState == SPORT_DATA_REQ) {
+    address = (frame[1] == PRIM_DATA_WORD ? address + 4 : 0);
+  }
+  state = newState;
   static uint8_t pass = 0;
   if (++pass == 10) {
     pass = 0;
@@ -299,6 +303,7 @@ const char * FrskyDeviceFirmwareUpdate::sendReqVersion()
   telemetryClearFifo();
 
   state = SPORT_VERSION_REQ;
+  bootloaderVersion = 0;
   for (int i=0; i<10; i++) {
     // max 10 attempts
     startFrame(PRIM_REQ_VERSION) ;
@@ -372,11 +377,13 @@ const char * FrskyDeviceFirmwareUpdate::doFlashFirmware(const char * filename, P
       etx_serial_init params(serialInitParams);
       params.baudrate = 57600;
       uart_ctx = IntmoduleSerialDriver.init(&params);
+      fullDuplex = true;
     } break;
 #endif
 
     default:
       telemetryInit(PROTOCOL_TELEMETRY_FRSKY_SPORT);
+      fullDuplex = false;
       break;
   }
 
@@ -451,10 +458,20 @@ const char * FrskyDeviceFirmwareUpdate::uploadFileToHorusXJT(const char * filena
 }
 #endif
 
+#define FIRMWARE_READ_AHEAD_SIZE  1024
+#define FIRMWARE_RESEND_TIMEOUT   100 // ms
+#define FIRMWARE_REQUEST_TIMEOUT  2000 // ms
+
+// The device requests the address of the word it expects next, which
+// acknowledges all the previous ones. Up to `window` words are sent ahead of
+// this request, and sent again from the requested address when the device asks
+// twice for the same word or stops answering. With a window of 1, this is the
+// original stop-and-wait transfer.
 const char * FrskyDeviceFirmwareUpdate::uploadFileNormal(const char * filename, FIL * file, ProgressHandler progressHandler)
 {
-  uint32_t buffer[1024 / sizeof(uint32_t)];
-  UINT count;
+  uint32_t buffer[FIRMWARE_READ_AHEAD_SIZE / sizeof(uint32_t)];
+  uint32_t bufferOffset = 0;
+  UINT count = 0;
 
   const char * result = sendPowerOn();
   if (result)
@@ -467,34 +484,111 @@ const char * FrskyDeviceFirmwareUpdate::uploadFileNormal(const char * filename,
   RTOS_WAIT_MS(200);
   telemetryClearFifo();
 
+  if (!fullDuplex) {
+    // half duplex: the device answer would collide with the next word
+    window = 1;
+  }
+  else if (requestedWindow) {
+    window = requestedWindow;
+  }
+#if FIRMWARE_PXX2_WINDOW_MIN_VERSION > 0
+  else if (bootloaderVersion >= FIRMWARE_PXX2_WINDOW_MIN_VERSION) {
+    // the next words are sent while the device answers
+    window = FIRMWARE_PXX2_WINDOW;
+  }
+#endif
+  else {
+    window = 1;
+  }
+
+  // the firmware starts after the .frsky header, trailing bytes are not sent
+  uint32_t start = file->fptr;
+  uint32_t size = (file->obj.objsize - start) & ~3u;
+  uint32_t windowSize = window * sizeof(uint32_t);
+
   state = SPORT_DATA_TRANSFER;
   startFrame(PRIM_CMD_DOWNLOAD);
   sendFrame();
 
+  if (!waitState(SPORT_DATA_REQ, FIRMWARE_REQUEST_TIMEOUT)) {
+    return STR_DEVICE_DATA_REFUSED;
+  }
+
+  // the device flash address of the first byte of the firmware
+  uint32_t base = address & ~1023u;
+  uint32_t acked = 0; // offset requested by the device
+  uint32_t next = 0;  // offset of the next word to be sent
+  uint8_t retries = 0;
+  uint8_t duplicates = 0; // requests expected for the words sent again
+
   while (true) {
-    if (f_read(file, buffer, 1024, &count) != FR_OK) {
-        return STR_DEVICE_FILE_ERROR;
-    }
+    bool resend = false;
 
-    count >>= 2;
+    if (state == SPORT_DATA_REQ) {
+      if (address < base) {
+        return STR_DEVICE_WRONG_REQUEST;
+      }
+      uint32_t requested = address - base;
+      if (requested >= size) {
+        break;
+      }
+      if (requested > acked) {
+        acked = requested;
+        retries = duplicates = 0;
+        if (next < acked) {
+          next = acked;
+        }
+        if ((acked & 1023) < windowSize) {
+          progressHandler(getBasename(filename), STR_WRITING, acked, size);
+        }
+      }
+      else if (requested == acked) {
+        // the device asks again, the words sent were lost, unless this answers
+        // one of the words already sent again
+        if (duplicates > 0)
+          duplicates--;
+        else
+          resend = true;
+      }
+      else if (window == 1 || acked - requested > windowSize) {
+        acked = next = requested;
+      }
+      // else an outdated request, overtaken by a more recent one
+    }
+    else {
+      // no answer
+      resend = true;
+    }
 
-    for (uint32_t i=0; i<count; i++) {
-      if (!waitState(SPORT_DATA_REQ, 2000)) {
+    if (resend) {
+      if (window > 1 && ++retries == FIRMWARE_REQUEST_TIMEOUT / FIRMWARE_RESEND_TIMEOUT) {
         return STR_DEVICE_DATA_REFUSED;
       }
+      next = acked;
+      duplicates = window - 1;
+    }
+
+    state = SPORT_DATA_TRANSFER;
+    while (next < size && next < acked + windowSize) {
+      if (next < bufferOffset || next >= bufferOffset + count) {
+        bufferOffset = next & ~(FIRMWARE_READ_AHEAD_SIZE - 1);
+        if (f_lseek(file, start + bufferOffset) != FR_OK ||
+            f_read(file, buffer, FIRMWARE_READ_AHEAD_SIZE, &count) != FR_OK ||
+            next >= bufferOffset + count) {
+          return STR_DEVICE_FILE_ERROR;
+        }
+      }
       startFrame(PRIM_DATA_WORD);
-      uint32_t offset = (address & 1023) >> 2; // 32 bit word offset into buffer
-      *((uint32_t *)(frame + 2)) = buffer[offset];
-      frame[6] = address & 0x000000FF;
-      state = SPORT_DATA_TRANSFER,
+      *((uint32_t *)(frame + 2)) = buffer[(next - bufferOffset) >> 2];
+      frame[6] = (base + next) & 0x000000FF;
       sendFrame();
-      if (i == 0) {
-        progressHandler(getBasename(filename), STR_WRITING, file->fptr, file->obj.objsize);
-      }
+      next += sizeof(uint32_t);
     }
 
-    if (count < 256) {
-      break;
+    if (!waitState(SPORT_DATA_REQ, window == 1 ? FIRMWARE_REQUEST_TIMEOUT : FIRMWARE_RESEND_TIMEOUT)) {
+      if (state == SPORT_FAIL || window == 1) {
+        return STR_DEVICE_DATA_REFUSED;
+      }
     }
   }
 
@@ -503,14 +597,18 @@ const char * FrskyDeviceFirmwareUpdate::uploadFileNormal(const char * filename,
 
 const char * FrskyDeviceFirmwareUpdate::endTransfer()
 {
-  if (!waitState(SPORT_DATA_REQ, 2000))
-      return STR_DEVICE_DATA_REFUSED;
   startFrame(PRIM_DATA_EOF);
   sendFrame();
-  if (!waitState(SPORT_COMPLETE, 2000)) {
-    return STR_DEVICE_FILE_REJECTED;
+  // requests still in flight may be received before the end of download
+  for (uint8_t i = 0; i < window; i++) {
+    if (waitState(SPORT_COMPLETE, FIRMWARE_REQUEST_TIMEOUT)) {
+      return nullptr;
+    }
+    if (state == SPORT_FAIL) {
+      break;
+    }
   }
-  return nullptr;
+  return STR_DEVICE_FILE_REJECTED;
 }
 
 const char * FrskyDeviceFirmwareUpdate::flashFirmware(const char * filename, ProgressHandler progressHandler)
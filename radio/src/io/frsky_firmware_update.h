@@ -25,6 +25,15 @@
 #include "dataconstants.h"
 #include "definitions.h"
 
+// Max number of data words sent ahead of the device requests
+#define FIRMWARE_MAX_WINDOW   16
+// Window used on the full duplex link of the internal PXX2 module, only with
+// the bootloaders known to accept words sent ahead of their requests: from
+// FIRMWARE_PXX2_WINDOW_MIN_VERSION (as answered to the version request), none
+// has been validated yet (0)
+#define FIRMWARE_PXX2_WINDOW              8
+#define FIRMWARE_PXX2_WINDOW_MIN_VERSION  0
+
 enum FrskyFirmwareProductFamily {
   FIRMWARE_FAMILY_INTERNAL_MODULE,
   FIRMWARE_FAMILY_EXTERNAL_MODULE,
@@ -126,22 +135,36 @@ class FrskyDeviceFirmwareUpdate {
       module(module) {
     }
 
+    virtual ~FrskyDeviceFirmwareUpdate() = default;
+
+    // Number of data words sent before waiting for the device requests,
+    // instead of the one chosen from the bootloader version. Only used on
+    // full duplex links (S.Port is half duplex)
+    void setWindow(uint8_t value)
+    {
+      requestedWindow = limit<uint8_t>(1, value, FIRMWARE_MAX_WINDOW);
+    }
+
     const char * flashFirmware(const char * filename, ProgressHandler progressHandler);
 
   protected:
     uint8_t state = SPORT_IDLE;
     uint32_t address = 0;
     ModuleIndex module;
+    uint8_t window = 1; // data words sent ahead of the device requests
+    uint8_t requestedWindow = 0;
+    bool fullDuplex = false;
+    uint32_t bootloaderVersion = 0;
     uint8_t frame[12];
     void* uart_ctx = nullptr;
 
     void startFrame(uint8_t command);
-    void sendFrame();
+    virtual void sendFrame();
 
     bool readBuffer(uint8_t * buffer, uint8_t count, uint32_t timeout);
     const uint8_t * readFullDuplexFrame(uint32_t timeout);
     const uint8_t * readHalfDuplexFrame(uint32_t timeout);
-    const uint8_t * readFrame(uint32_t timeout);
+    virtual const uint8_t * readFrame(uint32_t timeout);
     bool waitState(State state, uint32_t timeout);
     void processFrame(const uint8_t * frame);
 
@@ -21,6 +21,8 @@
 
 #include <cctype>
 #include <cstdio>
+#include <list>
+#include <string>
 #include "opentx.h"
 #include "libopenui.h"
 #include "widget.h"
@@ -508,6 +510,9 @@ Loads a bitmap in memory, for later use with lcd.drawBitmap(). Bitmaps should be
 once, returned object should be stored and used for drawing. If loading fails for whatever
 reason the resulting bitmap object will have width and height set to zero.
 
+Opening again a file that has not changed since returns a bitmap sharing the
+same memory, without loading the file again.
+
 Bitmap loading can fail if:
  * File is not found or contains invalid image
  * System is low on memory
@@ -521,31 +526,126 @@ Bitmap loading can fail if:
 
 @status current Introduced in 2.2.0
 */
-static int luaOpenBitmap(lua_State *L)
+// Bitmaps opened by Bitmap.open() are shared by all the Lua objects (in any
+// Lua state) opening the same unchanged file. Unused ones are kept for later
+// Bitmap.open() calls until their memory is needed.
+struct LuaBitmap {
+  std::string path;  // empty when it can't be shared
+  WORD fdate;
+  WORD ftime;
+  BitmapBuffer * bitmap;
+  uint16_t refs;
+};
+
+static std::list<LuaBitmap> luaBitmaps;  // most recently opened first
+
+static uint32_t luaBitmapDecoded = 0;
+static uint32_t luaBitmapShared = 0;
+static uint32_t luaExtraMemoryPeak = 0;
+
+static void luaFreeBitmap(std::list<LuaBitmap>::iterator it)
 {
-  const char *filename = luaL_checkstring(L, 1);
+  uint32_t size = it->bitmap->getDataSize();
+  TRACE("luaFreeBitmap: %p (%u)", it->bitmap, size);
+  if (luaExtraMemoryUsage >= size) {
+    luaExtraMemoryUsage -= size;
+  }
+  else {
+    luaExtraMemoryUsage = 0;
+  }
+  delete it->bitmap;
+  luaBitmaps.erase(it);
+}
+
+// Frees the least recently opened unused bitmaps until the extra memory
+// usage is below 'limit'
+static uint32_t luaFreeUnusedBitmaps(uint32_t limit)
+{
+  uint32_t freed = 0;
+  auto it = luaBitmaps.end();
+  while (it != luaBitmaps.begin() && luaExtraMemoryUsage > limit) {
+    --it;
+    if (it->refs == 0) {
+      freed += it->bitmap->getDataSize();
+      luaFreeBitmap(it++);
+    }
+  }
+  return freed;
+}
+
+uint32_t luaFreeUnusedBitmaps()
+{
+  return luaFreeUnusedBitmaps(0);
+}
+
+static LuaBitmap * luaGetBitmap(lua_State * L, const char * filename)
+{
+  FILINFO info;
+  bool shared = (f_stat(filename, &info) == FR_OK);
+
+  if (shared) {
+    for (auto it = luaBitmaps.begin(); it != luaBitmaps.end(); ++it) {
+      if (it->path == filename) {
+        if (it->fdate == info.fdate && it->ftime == info.ftime) {
+          it->refs++;
+          luaBitmapShared++;
+          luaBitmaps.splice(luaBitmaps.begin(), luaBitmaps, it);
+          return &luaBitmaps.front();
+        }
+        // the file has changed
+        if (it->refs == 0)
+          luaFreeBitmap(it);
+        else
+          it->path.clear();
+        break;
+      }
+    }
+  }
 
-  BitmapBuffer **b =
-      (BitmapBuffer **)lua_newuserdata(L, sizeof(BitmapBuffer *));
+  if (luaExtraMemoryUsage > LUA_MEM_EXTRA_MAX) {
+    luaFreeUnusedBitmaps(LUA_MEM_EXTRA_MAX);
+  }
 
   if (luaExtraMemoryUsage > LUA_MEM_EXTRA_MAX) {
     // already allocated more than max allowed, fail
     TRACE("luaOpenBitmap: Error, using too much memory %u/%u",
           luaExtraMemoryUsage, LUA_MEM_EXTRA_MAX);
-    *b = 0;
-  } else {
-    *b = BitmapBuffer::loadBitmap(filename);
-    if (*b == NULL && G(L)->gcrunning) {
-      luaC_fullgc(L, 1);                       /* try to free some memory... */
-      *b = BitmapBuffer::loadBitmap(filename); /* try again */
-    }
+    return nullptr;
+  }
+
+  BitmapBuffer * bitmap = BitmapBuffer::loadBitmap(filename);
+  if (bitmap == NULL && luaFreeUnusedBitmaps()) {
+    bitmap = BitmapBuffer::loadBitmap(filename); /* try again */
+  }
+  if (bitmap == NULL && G(L)->gcrunning) {
+    luaC_fullgc(L, 1);                         /* try to free some memory... */
+    luaFreeUnusedBitmaps();
+    bitmap = BitmapBuffer::loadBitmap(filename); /* try again */
+  }
+  if (bitmap == NULL) {
+    return nullptr;
   }
 
-  if (*b) {
-    uint32_t size = (*b)->getDataSize();
-    luaExtraMemoryUsage += size;
-    TRACE("luaOpenBitmap: %p (%u)", *b, size);
+  uint32_t size = bitmap->getDataSize();
+  luaExtraMemoryUsage += size;
+  if (luaExtraMemoryUsage > luaExtraMemoryPeak) {
+    luaExtraMemoryPeak = luaExtraMemoryUsage;
   }
+  luaBitmapDecoded++;
+  TRACE("luaOpenBitmap: %p (%u), %u decoded, %u shared, peak %u", bitmap,
+        size, luaBitmapDecoded, luaBitmapShared, luaExtraMemoryPeak);
+
+  luaBitmaps.push_front({shared ? filename : "", shared ? info.fdate : (WORD)0,
+                         shared ? info.ftime : (WORD)0, bitmap, 1});
+  return &luaBitmaps.front();
+}
+
+static int luaOpenBitmap(lua_State *L)
+{
+  const char *filename = luaL_checkstring(L, 1);
+
+  LuaBitmap **b = (LuaBitmap **)lua_newuserdata(L, sizeof(LuaBitmap *));
+  *b = luaGetBitmap(L, filename);
 
   luaL_getmetatable(L, LUA_BITMAPHANDLE);
   lua_setmetatable(L, -2);
@@ -555,8 +655,8 @@ static int luaOpenBitmap(lua_State *L)
 
 static BitmapBuffer * checkBitmap(lua_State * L, int index)
 {
-  BitmapBuffer ** b = (BitmapBuffer **)luaL_checkudata(L, index, LUA_BITMAPHANDLE);
-  return *b;
+  LuaBitmap ** b = (LuaBitmap **)luaL_checkudata(L, index, LUA_BITMAPHANDLE);
+  return *b ? (*b)->bitmap : nullptr;
 }
 
 /*luadoc
@@ -590,18 +690,17 @@ static int luaGetBitmapSize(lua_State * L)
 
 static int luaDestroyBitmap(lua_State * L)
 {
-  BitmapBuffer * b = checkBitmap(L, 1);
-  if (b) {
-    uint32_t size = b->getDataSize();
-    TRACE("luaDestroyBitmap: %p (%u)", b, size);
-    if (luaExtraMemoryUsage >= size) {
-      luaExtraMemoryUsage -= size;
-    }
-    else {
-      luaExtraMemoryUsage = 0;
+  LuaBitmap ** b = (LuaBitmap **)luaL_checkudata(L, 1, LUA_BITMAPHANDLE);
+  if (*b && --(*b)->refs == 0 && (*b)->path.empty()) {
+    // can't be shared any more
+    for (auto it = luaBitmaps.begin(); it != luaBitmaps.end(); ++it) {
+      if (&(*it) == *b) {
+        luaFreeBitmap(it);
+        break;
+      }
     }
-    delete b;
   }
+  *b = nullptr;
   return 0;
 }
 
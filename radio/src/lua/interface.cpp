@@ -1232,6 +1232,10 @@ void checkLuaMemoryUsage()
 #if defined(COLORLCD)
   totalMemUsed += luaGetMemUsed(lsWidgets);
   totalMemUsed += luaExtraMemoryUsage;
+  if (totalMemUsed > LUA_MEM_MAX) {
+    // bitmaps kept for later Bitmap.open() calls go first
+    totalMemUsed -= luaFreeUnusedBitmaps();
+  }
 #endif
   if (totalMemUsed > LUA_MEM_MAX) {
     TRACE_ERROR("checkLuaMemoryUsage(): max limit reached (%u), killing Lua\n", totalMemUsed);
@@ -64,6 +64,7 @@ extern bool luaLcdAllowed;
 #if defined(COLORLCD)
 extern lua_State * lsWidgets;
 extern uint32_t luaExtraMemoryUsage;
+uint32_t luaFreeUnusedBitmaps();
 void luaInitThemesAndWidgets();
 #endif
 
@@ -22,6 +22,7 @@
 #include "lua_widget.h"
 #include "lua_widget_factory.h"
 
+#include "opentx.h"
 #include "lua_api.h"
 #include "lua_event.h"
 #include "api_colorlcd.h"
@@ -190,24 +191,66 @@ void LuaWidget::onCancel()
   LuaEventHandler::onCancel();
 }
 
+#define LUA_WIDGET_STATS_PERIOD  1000 // 10s
+
+// Time elapsed since start, in us. The 2MHz timer wraps every 32.768ms:
+// it gives the time modulo that period, and the 10ms tick, which is off
+// by less than half a period, gives the number of wraps.
+static uint32_t getElapsedUs(uint16_t start2MHz, tmr10ms_t start10ms)
+{
+  int32_t us = (uint16_t)(getTmr2MHz() - start2MHz) / 2;
+  int32_t ticksUs = (int32_t)(get_tmr10ms() - start10ms) * 10000;
+  return us + (ticksUs - us + 16384) / 32768 * 32768;
+}
+
 void LuaWidget::checkEvents()
 {
   Widget::checkEvents();
 
-  // paint has not been called
-  if (!refreshed) {
+  // paint has not been called since the last invalidate(), or the
+  // widget has been hidden since: it is not visible
+  bool visible = refreshed && lv_obj_is_visible(lvobj);
+  if (!visible) {
     background();
-    refreshed = true;
+    // background() runs on every cycle until refresh() is called again
+    refreshDelay = 0;
   }
-  
-  refreshed = false;
-  invalidate();
+
+  // a visible widget is only repainted once its refresh delay is over,
+  // a fullscreen one needs its refresh() to be called for the events
+  if (!visible || fullscreen ||
+      (tmr10ms_t)(get_tmr10ms() - lastRefreshTime) >= refreshDelay) {
+    refreshed = false;
+    invalidate();
+  }
+  else {
+    skippedCount++;
+  }
+
+  traceStats();
 
 #if defined(DEBUG_WINDOWS)
     TRACE_WINDOWS("# refresh: %s", getWindowDebugString().c_str());
 #endif
 }
 
+void LuaWidget::traceStats()
+{
+  tmr10ms_t now = get_tmr10ms();
+  if ((tmr10ms_t)(now - statsTime) < LUA_WIDGET_STATS_PERIOD)
+    return;
+
+  if (refreshCount) {
+    TRACE("Lua widget %s: %u refresh (%u skipped), %uus average, %uus max",
+          factory->getName(), refreshCount, skippedCount,
+          luaTime / refreshCount, maxLuaTime);
+  }
+
+  statsTime = now;
+  refreshCount = skippedCount = luaTime = 0;
+  maxLuaTime = 0;
+}
+
 static void l_pushtableint(const char * key, int value)
 {
   lua_pushstring(lsWidgets, key);
@@ -247,6 +290,9 @@ void LuaWidget::update()
   if (lua_pcall(lsWidgets, 2, 0, 0) != 0) {
     setErrorMessage("update()");
   }
+
+  // options changed, repaint on next cycle
+  refreshDelay = 0;
 }
 
 void LuaWidget::onFullscreen(bool enable)
@@ -320,9 +366,31 @@ void LuaWidget::refresh(BitmapBuffer* dc)
   luaLcdAllowed = true;
   runningFS = this;
 
-  if (lua_pcall(lsWidgets, 3, 0, 0) != 0) {
+  // refresh() may return the delay before it needs to be called again
+  // (in 10ms units), otherwise the widget 'refreshPeriod' applies
+  refreshDelay = factory->refreshPeriod;
+  uint16_t start = getTmr2MHz();
+  tmr10ms_t startTime = get_tmr10ms();
+
+  if (lua_pcall(lsWidgets, 3, 1, 0) != 0) {
     setErrorMessage("refresh()");
   }
+  else {
+    // luaL_optinteger() would raise an error on anything else than a
+    // number or nil, which must not happen out of lua_pcall()
+    if (lua_isnumber(lsWidgets, -1)) {
+      refreshDelay = limit<lua_Integer>(
+          0, luaL_optinteger(lsWidgets, -1, refreshDelay),
+          LUA_WIDGET_MAX_REFRESH_DELAY);
+    }
+    lua_pop(lsWidgets, 1);
+  }
+
+  uint32_t duration = getElapsedUs(start, startTime);
+  luaTime += duration;
+  if (duration > maxLuaTime) maxLuaTime = duration;
+  refreshCount++;
+
   runningFS = nullptr;
   // Remove LCD
   luaLcdAllowed = lla;
@@ -330,6 +398,7 @@ void LuaWidget::refresh(BitmapBuffer* dc)
 
   // mark as refreshed
   refreshed = true;
+  lastRefreshTime = get_tmr10ms();
 }
 
 void LuaWidget::background()
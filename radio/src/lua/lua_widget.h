@@ -48,6 +48,8 @@ public:
   void removeHandler(Window* w);
 };
 
+#define LUA_WIDGET_MAX_REFRESH_DELAY  UINT16_MAX
+
 class LuaWidget : public Widget, public LuaEventHandler
 {
   friend class LuaWidgetFactory;
@@ -56,6 +58,20 @@ class LuaWidget : public Widget, public LuaEventHandler
   char* errorMessage;
   bool refreshed = false;
 
+  // time of the last refresh() call and delay before the next one,
+  // in 10ms units, up to LUA_WIDGET_MAX_REFRESH_DELAY
+  tmr10ms_t lastRefreshTime = 0;
+  uint16_t refreshDelay = 0;
+
+  // refresh() statistics, traced periodically
+  uint32_t refreshCount = 0;
+  uint32_t skippedCount = 0;
+  uint32_t luaTime = 0;
+  uint32_t maxLuaTime = 0;
+  tmr10ms_t statsTime = 0;
+
+  void traceStats();
+
   // Window interface
   void onClicked() override;
   void onCancel() override;
@@ -40,7 +40,8 @@ LuaWidgetFactory::LuaWidgetFactory(const char* name, ZoneOption* widgetOptions,
     createFunction(createFunction),
     updateFunction(0),
     refreshFunction(0),
-    backgroundFunction(0)
+    backgroundFunction(0),
+    refreshPeriod(0)
 {
 }
 
@@ -42,4 +42,6 @@ class LuaWidgetFactory : public WidgetFactory
   int updateFunction;
   int refreshFunction;
   int backgroundFunction;
+  // default minimum time between two refresh() calls, in 10ms units
+  uint16_t refreshPeriod;
 };
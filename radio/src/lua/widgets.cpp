@@ -225,6 +225,7 @@ void luaLoadWidgetCallback()
 
   int widgetOptions = 0, createFunction = 0, updateFunction = 0,
       refreshFunction = 0, backgroundFunction = 0;
+  uint16_t refreshPeriod = 0;
 
   luaL_checktype(lsWidgets, -1, LUA_TTABLE);
 
@@ -253,6 +254,10 @@ void luaLoadWidgetCallback()
       backgroundFunction = luaL_ref(lsWidgets, LUA_REGISTRYINDEX);
       lua_pushnil(lsWidgets);
     }
+    else if (!strcmp(key, "refreshPeriod")) {
+      refreshPeriod = limit<lua_Integer>(0, luaL_checkinteger(lsWidgets, -1),
+                                         LUA_WIDGET_MAX_REFRESH_DELAY);
+    }
   }
 
   if (name && createFunction) {
@@ -262,6 +267,7 @@ void luaLoadWidgetCallback()
       factory->updateFunction = updateFunction;
       factory->refreshFunction = refreshFunction;
       factory->backgroundFunction = backgroundFunction;   // NOSONAR
+      factory->refreshPeriod = refreshPeriod;
       TRACE("Loaded Lua widget %s", name);
     }
   }
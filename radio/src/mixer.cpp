@@ -963,10 +963,20 @@ void evalMixes(uint8_t tick10ms)
   static uint16_t delta = 0;
   static uint16_t flightModesFade = 0;
 
+  // outputs of the inactive flight modes being faded, evaluated once per
+  // 10ms tick only (they don't depend on the mixer cycle timing)
+  static int16_t fadeChans[MAX_FLIGHT_MODES][MAX_OUTPUT_CHANNELS];
+  static uint16_t fadeChansValid = 0;
+
+#if defined(GVARS)
+  checkGVars();
+#endif
+
   uint8_t fm = getFlightMode();
 
   if (lastFlightMode != fm) {
     flightModeTransitionTime = get_tmr10ms();
+    fadeChansValid = 0;
 
     if (lastFlightMode == 255) {
       fp_act[fm] = MAX_ACT;
@@ -1001,13 +1011,24 @@ void evalMixes(uint8_t tick10ms)
 
   int32_t weight = 0;
   if (flightModesFade) {
+    if (tick10ms) {
+      fadeChansValid = 0;
+    }
     memclear(sum_chans512, sizeof(sum_chans512));
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
-      if (flightModesFade & (0x01 << p)) {
-        mixerCurrentFlightMode = p;
-        evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+      uint16_t flightModeMask = (0x01 << p);
+      if (flightModesFade & flightModeMask) {
+        int16_t * modeChans = fadeChans[p];
+        if (p == fm || !(fadeChansValid & flightModeMask)) {
+          mixerCurrentFlightMode = p;
+          evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+          for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
+            modeChans[i] = limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff);
+          if (p != fm)
+            fadeChansValid |= flightModeMask;
+        }
         for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
-          sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
+          sum_chans512[i] += modeChans[i] * fp_act[p];
         weight += fp_act[p];
       }
     }
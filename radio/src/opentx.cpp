@@ -1820,6 +1820,8 @@ void opentxInit()
   startPulses();
 
   WDG_ENABLE(WDG_DURATION);
+
+  TRACE("opentxInit done at %d ms", RTOS_GET_MS());
 }
 
 #if defined(SEMIHOSTING)
@@ -589,13 +589,19 @@ uint16_t isqrt32(uint32_t n);
 #else
 #include "tasks.h"
 extern RTOS_MUTEX_HANDLE mixerMutex;
+
+// Module frames are built outside of mixerMutex, under pulsesMutex: both
+// are held while the mixer is paused, so that neither the mixer nor the
+// frames being built read the model data while it is changed
 inline void pauseMixerCalculations()
 {
   RTOS_LOCK_MUTEX(mixerMutex);
+  RTOS_LOCK_MUTEX(pulsesMutex);
 }
 
 inline void resumeMixerCalculations()
 {
+  RTOS_UNLOCK_MUTEX(pulsesMutex);
   RTOS_UNLOCK_MUTEX(mixerMutex);
 }
 #endif
@@ -88,10 +88,20 @@ static void updateMultiSync(uint8_t module)
   }
 }
 
+static void sendPackedChannels(uint8_t moduleIdx, const uint16_t * values)
+{
+  uint8_t channels[MULTI_CHANS * MULTI_CHAN_BITS / 8];
+  for (uint8_t i = 0; i < MULTI_CHANS / 8; i++) {
+    pack11BitsChannels(&channels[i * 11], &values[i * 8]);
+  }
+  for (uint8_t i = 0; i < sizeof(channels); i++) {
+    sendMulti(moduleIdx, channels[i]);
+  }
+}
+
 static void sendFailsafeChannels(uint8_t moduleIdx)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint16_t values[MULTI_CHANS];
 
   for (int i = 0; i < MULTI_CHANS; i++) {
     int16_t failsafeValue = g_model.failsafeChannels[i];
@@ -111,14 +121,10 @@ static void sendFailsafeChannels(uint8_t moduleIdx)
       pulseValue = limit(1, (failsafeValue * 800 / 1000) + 1024, 2046);
     }
 
-    bits |= pulseValue << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendMulti(moduleIdx, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    values[i] = pulseValue;
   }
+
+  sendPackedChannels(moduleIdx, values);
 }
 
 void setupPulsesMulti(uint8_t moduleIdx)
@@ -293,8 +299,7 @@ const etx_module_driver_t MultiInternalDriver = {
 
 void sendChannels(uint8_t moduleIdx)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint16_t values[MULTI_CHANS];
 
   // byte 4-25, channels 0..2047
   // Range for pulses (channelsOutputs) is [-1024:+1024] for [-100%;100%]
@@ -305,16 +310,10 @@ void sendChannels(uint8_t moduleIdx)
 
     // Scale to 80%
     value = value * 800 / 1000 + 1024;
-    value = limit(0, value, 2047);
-
-    bits |= value << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendMulti(moduleIdx, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    values[i] = limit(0, value, 2047);
   }
+
+  sendPackedChannels(moduleIdx, values);
 }
 
 void convertMultiProtocolToEtx(int *protocol, int *subprotocol)
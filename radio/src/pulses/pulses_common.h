@@ -88,4 +88,22 @@ class PulsesBuffer: public DataBuffer<T, SIZE> {
     }
 };
 
+// Packs 8 channels of 11 bits each, LSB first, into 11 bytes (the layout of
+// CRSF, SBUS and Multi channels frames). Values must fit in 11 bits.
+inline void pack11BitsChannels(uint8_t * out, const uint16_t * values)
+{
+  uint64_t low = (uint64_t)values[0] | ((uint64_t)values[1] << 11) |
+                 ((uint64_t)values[2] << 22) | ((uint64_t)values[3] << 33) |
+                 ((uint64_t)values[4] << 44) | ((uint64_t)values[5] << 55);
+  uint32_t high = (values[5] >> 9) | ((uint32_t)values[6] << 2) |
+                  ((uint32_t)values[7] << 13);
+
+  for (uint8_t i = 0; i < 8; i++) {
+    out[i] = low >> (8 * i);
+  }
+  out[8] = high;
+  out[9] = high >> 8;
+  out[10] = high >> 16;
+}
+
 #endif
@@ -106,21 +106,20 @@ void setupPulsesSbus()
   // Sync Byte
   sendByteSbus(SBUS_FRAME_BEGIN_BYTE);
 
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
   // byte 1-22, channels 0..2047, limits not really clear (B
+  uint16_t values[SBUS_NORMAL_CHANS];
   for (int i=0; i<SBUS_NORMAL_CHANS; i++) {
     int value = getChannelValue(EXTERNAL_MODULE, i);
 
     value =  value*8/10 + SBUS_CHAN_CENTER;
-    bits |= limit(0, value, 2047) << bitsavailable;
-    bitsavailable += SBUS_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByteSbus((uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    values[i] = limit(0, value, 2047);
+  }
+
+  uint8_t channels[SBUS_NORMAL_CHANS * SBUS_CHAN_BITS / 8];
+  pack11BitsChannels(&channels[0], &values[0]);
+  pack11BitsChannels(&channels[11], &values[8]);
+  for (uint8_t i=0; i<sizeof(channels); i++) {
+    sendByteSbus(channels[i]);
   }
 
   // flags
@@ -65,6 +65,38 @@ void sbusSetGetByte(int (*fct)(uint8_t*))
   sbusGetByte = fct;
 }
 
+void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size);
+
+// Filled from the AUX serial RX IRQ: one more than
+// SBUS_FRAME_SIZE means the frame was too long
+static uint8_t sbusAuxFrame[SBUS_FRAME_SIZE];
+static uint32_t sbusAuxFrameLen = 0;
+
+void sbusAuxReceiveData(uint8_t* data, uint32_t len)
+{
+  while (len--) {
+    if (sbusAuxFrameLen < SBUS_FRAME_SIZE) {
+      sbusAuxFrame[sbusAuxFrameLen++] = *data;
+    } else {
+      sbusAuxFrameLen = SBUS_FRAME_SIZE + 1;
+    }
+    data++;
+  }
+}
+
+void sbusAuxFrameEnd()
+{
+  // The frame is decoded as soon as the end of frame has been
+  // detected, instead of waiting for processSbusInput(). Like the
+  // PPM capture IRQ, this writes ppmInput from the IRQ: each channel
+  // is a single 16-bit store and ppmInputValidityTimer is set last,
+  // which is how the mixer reads them.
+  if (sbusGetByte == sbusAuxGetByte) {
+    processSbusFrame(sbusAuxFrame, ppmInput, sbusAuxFrameLen);
+  }
+  sbusAuxFrameLen = 0;
+}
+
 // Range for pulses (ppm input) is [-512:+512]
 void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size)
 {
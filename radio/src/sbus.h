@@ -33,6 +33,13 @@ void sbusSetAuxGetByte(void* ctx, int (*fct)(void*, uint8_t*));
 //  with sbusSetAuxGetByte()
 int sbusAuxGetByte(uint8_t* byte);
 
+// SBUS AUX frame input:
+//  to be used as serial driver receive and idle callbacks
+//  (called from the USART IRQ). The frame is decoded into ppmInput
+//  at the end of frame when AUX is the trainer input.
+void sbusAuxReceiveData(uint8_t* data, uint32_t len);
+void sbusAuxFrameEnd();
+
 // Setup general SBUS input source
 void sbusSetGetByte(int (*fct)(uint8_t*));
 
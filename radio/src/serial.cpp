@@ -144,6 +144,7 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
   void (*sendByte)(void*, uint8_t) = nullptr;
   int (*getByte)(void*, uint8_t*) = nullptr;
   void (*setRxCb)(void*, void (*)(uint8_t*, uint32_t)) = nullptr;
+  void (*setIdleCb)(void*, void (*)()) = nullptr;
 
   const etx_serial_driver_t* drv = nullptr;
   if (port) {
@@ -152,6 +153,7 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
       sendByte = drv->sendByte;
       getByte = drv->getByte;
       setRxCb = drv->setReceiveCb;
+      setIdleCb = drv->setIdleCb;
     }
   }  
 
@@ -159,6 +161,7 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
   (void)sendByte;
   (void)getByte;
   (void)setRxCb;
+  (void)setIdleCb;
 
   switch(mode) {
 #if defined(DEBUG)
@@ -185,8 +188,14 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
 
 #if defined(SBUS_TRAINER)
   case UART_MODE_SBUS_TRAINER:
-    sbusSetAuxGetByte(ctx, getByte);
-    // TODO: setRxCb (see MODE_LUA)
+    if (setRxCb && setIdleCb) {
+      // frames are decoded as soon as received
+      sbusSetAuxGetByte(ctx, nullptr);
+      setRxCb(ctx, sbusAuxReceiveData);
+      setIdleCb(ctx, sbusAuxFrameEnd);
+    } else {
+      sbusSetAuxGetByte(ctx, getByte);
+    }
     break;
 #endif
 
@@ -216,6 +225,14 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
   }
 }
 
+// Driver callbacks set by serialSetCallBacks(): they would otherwise
+// keep being called from the driver IRQ once the port mode is changed
+static void serialClearDriverCallbacks(void* ctx, const etx_serial_driver_t* drv)
+{
+  if (drv->setReceiveCb) drv->setReceiveCb(ctx, nullptr);
+  if (drv->setIdleCb) drv->setIdleCb(ctx, nullptr);
+}
+
 static void serialSetupPort(int mode, etx_serial_init& params)
 {
   switch (mode) {
@@ -318,6 +335,9 @@ void serialInit(uint8_t port_nr, int mode)
 
   if (state->port) {
     auto drv = state->port->uart;
+    if (drv) {
+      serialClearDriverCallbacks(state->usart_ctx, drv);
+    }
     if (drv && drv->deinit) {
       drv->deinit(state->usart_ctx);
     }
@@ -407,6 +427,9 @@ void serialStop(uint8_t port_nr)
   if (state->port) {
     auto port = state->port;
     auto drv = port->uart;
+    if (drv) {
+      serialClearDriverCallbacks(state->usart_ctx, drv);
+    }
     if (drv && drv->deinit) {
       drv->deinit(state->usart_ctx);
     }
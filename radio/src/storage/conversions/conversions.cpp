@@ -61,6 +61,116 @@ static void drawProgressScreen(const char* filename, int progress, int total)
 #endif
 }
 
+void patchFilenameToYaml(char* str)
+{
+  constexpr unsigned bin_len = sizeof(MODELS_EXT) - 1;
+  constexpr unsigned yml_len = sizeof(YAML_EXT) - 1;
+
+  // patch file extension
+  const char* ext = strrchr(str, '.');
+  if (ext && (strlen(ext) == bin_len) &&
+      !strncmp(ext, STR_MODELS_EXT, bin_len)) {
+    memcpy((void*)ext, (void*)STR_YAML_EXT, yml_len + 1);
+  }
+}
+
+#if STORAGE_CONVERSIONS < 221
+static unsigned getConversionBufferSize()
+{
+  return max(getModelDataSize_220(), getRadioDataSize_220());
+}
+
+// The binary data is converted in memory up to 220 and written
+// as YAML in one pass. The YAML file is first written under a
+// temporary name and renamed once complete, while the binary file
+// is left untouched: an interrupted conversion can be run again.
+static const char* convertBinFile(const char* path, int version,
+                                  uint8_t* data, bool isModel)
+{
+  char yaml_path[FF_MAX_LFN + 1];
+  strncpy(yaml_path, path, FF_MAX_LFN);
+  yaml_path[FF_MAX_LFN] = '\0';
+  patchFilenameToYaml(yaml_path);
+  if (!strcmp(yaml_path, path)) {
+    return STR_INCOMPATIBLE;
+  }
+
+  char tmp_path[FF_MAX_LFN + 1];
+  strcpy(tmp_path, yaml_path);
+  strcpy(strrchr(tmp_path, '.'), ".tmp");
+
+  unsigned size = isModel ? getModelDataSize_220() : getRadioDataSize_220();
+  memclear(data, size);
+
+  uint8_t file_version;
+  const char* error = loadFileBin(path, data, size, &file_version);
+  if (error) return error;
+
+#if STORAGE_CONVERSIONS < 220
+  if (version == 219) {
+    if (isModel)
+      convertModelData_219_to_220(data);
+    else
+      convertRadioData_219_to_220(data);
+    version = 220;
+  }
+#endif
+  if (version != 220) {
+    return STR_INCOMPATIBLE;
+  }
+
+  if (isModel)
+    error = writeModelData_220_to_221(tmp_path, data);
+  else
+    error = writeRadioData_220_to_221(tmp_path, data);
+
+  if (!error) {
+    f_unlink(yaml_path);
+    FRESULT result = f_rename(tmp_path, yaml_path);
+    if (result != FR_OK) {
+      error = SDCARD_ERROR(result);
+    }
+  }
+
+  if (error) {
+    f_unlink(tmp_path);
+  }
+
+  return error;
+}
+
+static void getModelFilePath(char* path, const char* filename)
+{
+  memcpy(path, MODELS_PATH, sizeof(MODELS_PATH)-1);
+  path[sizeof(MODELS_PATH)-1] = '/';
+  strcpy(&path[sizeof(MODELS_PATH)], filename);
+}
+
+static const char* convertBinModelFile(char* filename, int version,
+                                       uint8_t* data)
+{
+  char path[FF_MAX_LFN + 1];
+  getModelFilePath(path, filename);
+
+  const char* error = convertBinFile(path, version, data, true);
+  if (error) return error;
+
+  patchFilenameToYaml(filename);
+  return nullptr;
+}
+
+// a model converted before the conversion was interrupted
+static bool isModelConverted(const char* filename)
+{
+  char path[FF_MAX_LFN + 1];
+  getModelFilePath(path, filename);
+  patchFilenameToYaml(path);
+
+  FILINFO fno;
+  return f_stat(path, &fno) == FR_OK;
+}
+#endif
+
 void convertBinRadioData(const char * path, int version)
 {
   TRACE("convertRadioData(%s,%d)", path, version);
@@ -83,64 +193,51 @@ void convertBinRadioData(const char * path, int version)
   unsigned converted = 0;
   auto to_convert = modelslist.getModelsCount() + 1;
 
-  drawProgressScreen(RADIO_FILENAME, converted, to_convert);
-  TRACE("converting '%s' (%d/%d)", RADIO_FILENAME, converted, to_convert);
-
-#if STORAGE_CONVERSIONS < 220
-  if (version == 219) {
-    convertRadioData_219_to_220(path);
-    version = 220;
-  }
-#endif
-#if STORAGE_CONVERSIONS < 220
-  if (version == 220) {
-    convertRadioData_220_to_221(path);
-    version = 221;
-  }
-#endif
-  converted++;
-
-#if defined(SIMU)
-  RTOS_WAIT_MS(200);
+#if STORAGE_CONVERSIONS < 221
+  // one buffer for all the files
+  auto data = reinterpret_cast<uint8_t*>(malloc(getConversionBufferSize()));
 #endif
 
-  const char* error = nullptr;
+  // the radio settings are converted last: as long as the
+  // YAML radio settings do not exist, the conversion is run
+  // again on the next start, skipping the converted models
   for (auto category_ptr : modelslist.getCategories()) {
 
     auto model_it = category_ptr->begin();
 
     while(model_it != category_ptr->end()) {
 
-      uint8_t model_version = 0;
       auto* model_ptr = *model_it;
       char* filename = model_ptr->modelFilename;
 
       TRACE("converting '%s' (%d/%d)", filename, converted, to_convert);
       drawProgressScreen(filename, converted, to_convert);
 
-      // read only the version number (size=0)
-      error = readModelBin(filename, nullptr, 0, &model_version);
-      if (!error) {
-        // TODO: error handling
-        error = convertBinModelData(filename, model_version);
-        ++model_it;
-
-        if (error) {
-          TRACE("ERROR converting '%s': %s", filename, error);
-          category_ptr->removeModel(model_ptr);
-        } else {
-          PartialModel partial;
-          memclear(&partial, sizeof(PartialModel));
-          
-          readModelYaml(filename, reinterpret_cast<uint8_t*>(&partial), sizeof(partial));
-          model_ptr->setModelName(partial.header.name);
-        }
+      const char* error = nullptr;
+#if STORAGE_CONVERSIONS < 221
+      if (isModelConverted(filename)) {
+        patchFilenameToYaml(filename);
       } else {
-        TRACE("ERROR reading '%s': %s", filename, error);
+        uint8_t model_version = 0;
+        // read only the version number (size=0)
+        error = readModelBin(filename, nullptr, 0, &model_version);
+        if (!error) {
+          error = convertBinModelFile(filename, model_version, data);
+        }
+      }
+#endif
+      ++model_it;
 
+      if (error) {
+        TRACE("ERROR converting '%s': %s", filename, error);
         // remove that file from the models list
-        ++model_it;
         category_ptr->removeModel(model_ptr);
+      } else {
+        PartialModel partial;
+        memclear(&partial, sizeof(PartialModel));
+
+        readModelYaml(filename, reinterpret_cast<uint8_t*>(&partial), sizeof(partial));
+        model_ptr->setModelName(partial.header.name);
       }
 
       converted++;
@@ -156,47 +253,35 @@ void convertBinRadioData(const char * path, int version)
   // trigger models list reload
   modelslist.clear();
 #endif
-}
 
-void patchFilenameToYaml(char* str)
-{
-  constexpr unsigned bin_len = sizeof(MODELS_EXT) - 1;
-  constexpr unsigned yml_len = sizeof(YAML_EXT) - 1;
+  drawProgressScreen(RADIO_FILENAME, converted, to_convert);
+  TRACE("converting '%s' (%d/%d)", RADIO_FILENAME, converted, to_convert);
 
-  // patch file extension
-  const char* ext = strrchr(str, '.');
-  if (ext && (strlen(ext) == bin_len) &&
-      !strncmp(ext, STR_MODELS_EXT, bin_len)) {
-    memcpy((void*)ext, (void*)STR_YAML_EXT, yml_len + 1);
+#if STORAGE_CONVERSIONS < 221
+  const char* error = convertBinFile(path, version, data, false);
+  if (error) {
+    TRACE("ERROR converting '%s': %s", path, error);
   }
+  free(data);
+#endif
+
+#if defined(SIMU)
+  RTOS_WAIT_MS(200);
+#endif
 }
 
 const char* convertBinModelData(char* filename, int version)
 {
   TRACE("convertModelData(%s)", filename);
 
-  char path[FF_MAX_LFN + 1];
-  memcpy(path, MODELS_PATH, sizeof(MODELS_PATH)-1);
-  path[sizeof(MODELS_PATH)-1] = '/';
-  strcpy(&path[sizeof(MODELS_PATH)], filename);
-  
-#if STORAGE_CONVERSIONS < 220
-  if (version == 219) {
-    const char* error = convertModelData_219_to_220(path);
-    if (error) return error;
-    version = 220;
-  }
-#endif
 #if STORAGE_CONVERSIONS < 221
-  if (version == 220) {
-    const char* error = convertModelData_220_to_221(path);
-    if (error) return error;
-    version = 221;
-  }
-#endif
-
-  patchFilenameToYaml(filename);
+  auto data = reinterpret_cast<uint8_t*>(malloc(getModelDataSize_220()));
+  const char* error = convertBinModelFile(filename, version, data);
+  free(data);
+  return error;
+#else
   return nullptr;
+#endif
 }
 #endif
 
@@ -40,9 +40,11 @@ void eeConvertModel(int id, int version);
 
 
 // Conversions 219 to 220
+void convertModelData_219_to_220(void* data);
 const char* convertModelData_219_to_220(uint8_t id);
 const char* convertModelData_219_to_220(const char* filename);
 
+void convertRadioData_219_to_220(void* data);
 const char* convertRadioData_219_to_220();
 const char* convertRadioData_219_to_220(const char* path);
 
@@ -52,3 +54,10 @@ const char* convertModelData_220_to_221(const char* filename);
 
 const char* convertRadioData_220_to_221();
 const char* convertRadioData_220_to_221(const char* path);
+
+// 220 data in memory written as 221 YAML
+unsigned getModelDataSize_220();
+const char* writeModelData_220_to_221(const char* path, uint8_t* data);
+
+unsigned getRadioDataSize_220();
+const char* writeRadioData_220_to_221(const char* path, uint8_t* data);
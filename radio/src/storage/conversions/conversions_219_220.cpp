@@ -107,13 +107,11 @@ static void convertToStr(char* str, size_t len)
 
 void convertModelData_219_to_220(void* data)
 {
-  constexpr unsigned md_size = sizeof(bin_storage_220::ModelData);
   auto& model = *reinterpret_cast<bin_storage_220::ModelData*>(data);
 
-  auto oldModelAllocated = reinterpret_cast<bin_storage_220::ModelData*>(malloc(md_size));
-  bin_storage_220::ModelData& oldModel = *oldModelAllocated;
-
-  memcpy(&oldModel, &model, md_size);
+  // only the timers are read back from the old data
+  bin_storage_220::TimerData oldTimers[MAX_TIMERS_219];
+  memcpy(oldTimers, model.timers, sizeof(oldTimers));
   bin_storage_220::ModelData& newModel = (bin_storage_220::ModelData&)model;
   convertToStr(model.header.name, LEN_MODEL_NAME_219);
 
@@ -122,7 +120,7 @@ void convertModelData_219_to_220(void* data)
     bin_storage_220::TimerData& timer = newModel.timers[i];
     convertToStr(timer.name, LEN_TIMER_NAME_219);
 
-    TimerData_v219& timer_219 = *(TimerData_v219*)(&oldModel.timers[i]);
+    TimerData_v219& timer_219 = *(TimerData_v219*)(&oldTimers[i]);
 
     // Convert mode
 
@@ -243,7 +241,6 @@ void convertModelData_219_to_220(void* data)
   persistentData->options[4].type  = bin_storage_220::ZOV_Bool;
   persistentData->options[4].value.boolValue = false;
 #endif
-  free(oldModelAllocated);
 }
 
 #if !defined(EEPROM_RLC)
@@ -50,6 +50,14 @@ namespace yaml_conv_220 {
 
 void patchFilenameToYaml(char* str);
 
+static const char* writeData_220_to_221(
+    const char* path, uint8_t* data, const YamlNode* root_node,
+    void (*patchBinary)(uint8_t*))
+{
+  if (patchBinary) patchBinary(data);
+  return writeFileYaml(path, root_node, data);
+}
+
 static const char* convertData_220_to_221(
     const char* path, unsigned size, const YamlNode* root_node,
     void (*patchBinary)(uint8_t*) = nullptr)
@@ -60,14 +68,12 @@ static const char* convertData_220_to_221(
   uint8_t version;
   const char* error = loadFileBin(path, data, size, &version);
   if (!error) {
-    if (patchBinary) patchBinary(data);
-
     char output_fname[FF_MAX_LFN+1];
     strncpy(output_fname, path, FF_MAX_LFN);
     output_fname[FF_MAX_LFN] = '\0';
     
     patchFilenameToYaml(output_fname);
-    error = writeFileYaml(output_fname, root_node, data);
+    error = writeData_220_to_221(output_fname, data, root_node, patchBinary);
   }
 
   free(data);
@@ -117,6 +123,17 @@ static void patchModelData(uint8_t* data)
   #define patchModelData nullptr
 #endif
 
+unsigned getModelDataSize_220()
+{
+  return sizeof(bin_storage_220::ModelData);
+}
+
+const char* writeModelData_220_to_221(const char* path, uint8_t* data)
+{
+  return writeData_220_to_221(path, data, yaml_conv_220::get_modeldata_nodes(),
+                              patchModelData);
+}
+
 const char* convertModelData_220_to_221(const char* path)
 {
   constexpr unsigned md_size = sizeof(bin_storage_220::ModelData);
@@ -132,6 +149,17 @@ static void patchRadioData(uint8_t* data)
   patchFilenameToYaml(rd->currModelFilename);
 }
 
+unsigned getRadioDataSize_220()
+{
+  return sizeof(bin_storage_220::RadioData);
+}
+
+const char* writeRadioData_220_to_221(const char* path, uint8_t* data)
+{
+  return writeData_220_to_221(path, data, yaml_conv_220::get_radiodata_nodes(),
+                              patchRadioData);
+}
+
 const char* convertRadioData_220_to_221(const char* path)
 {
   constexpr unsigned rd_size = sizeof(bin_storage_220::RadioData);
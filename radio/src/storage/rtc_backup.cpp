@@ -43,26 +43,201 @@ RamBackup * ramBackup = &_ramBackup;
 RamBackup * ramBackup = (RamBackup *)BKPSRAM_BASE;
 #endif
 
+constexpr uint32_t RAM_BACKUP_SECTIONS =
+    (sizeof(ramBackupUncompressed) + RAM_BACKUP_SECTION_SIZE - 1) /
+    RAM_BACKUP_SECTION_SIZE;
+
+static_assert(RAM_BACKUP_SECTIONS <= 256, "Too many backup sections");
+
+// hashes and record sizes of the sections as committed in the backup RAM,
+// valid as long as the log is the one written by the last rambackupWrite()
+static uint32_t sectionHashes[RAM_BACKUP_SECTIONS];
+static uint16_t sectionSizes[RAM_BACKUP_SECTIONS];
+static uint32_t sectionsLog = 0;
+
+static uint8_t * sectionData(unsigned section)
+{
+  return (uint8_t *)&ramBackupUncompressed + section * RAM_BACKUP_SECTION_SIZE;
+}
+
+static uint32_t sectionLength(unsigned section)
+{
+  uint32_t offset = section * RAM_BACKUP_SECTION_SIZE;
+  return min<uint32_t>(RAM_BACKUP_SECTION_SIZE,
+                       sizeof(ramBackupUncompressed) - offset);
+}
+
+static uint32_t sectionHash(unsigned section)
+{
+  // FNV-1a
+  const uint8_t * data = sectionData(section);
+  uint32_t hash = 2166136261u;
+  for (uint32_t i = 0; i < sectionLength(section); i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static uint16_t recordCrc(const RamBackupRecord * record)
+{
+  uint16_t crc = crc16(CRC_1021, &record->section, sizeof(record->section));
+  return crc16(CRC_1021, (const uint8_t *)(record + 1), record->size, crc);
+}
+
+static bool getLog(uint32_t log, uint32_t & begin, uint32_t & end)
+{
+  begin = log & 0xFFFF;
+  end = log >> 16;
+  return begin < end && end <= sizeof(ramBackup->data);
+}
+
+static void setLog(uint32_t begin, uint32_t end)
+{
+  uint32_t log = begin | (end << 16);
+
+  // the records must be written to the backup RAM before they are committed
+#if defined(SIMU)
+  asm volatile("" ::: "memory");
+#else
+  __DMB();
+#endif
+  *(volatile uint32_t *)&ramBackup->log = log;
+  sectionsLog = log;
+}
+
+// Writes a record for the section at offset, returns the offset after it,
+// or 0 if it does not fit before limit
+static uint32_t writeSection(unsigned section, uint32_t offset, uint32_t limit,
+                             uint16_t * sizes)
+{
+  if (offset + sizeof(RamBackupRecord) >= limit)
+    return 0;
+
+  auto record = (RamBackupRecord *)&ramBackup->data[offset];
+  unsigned int size = compress((uint8_t *)(record + 1),
+                               limit - offset - sizeof(RamBackupRecord),
+                               sectionData(section), sectionLength(section));
+  if (size == 0)
+    return 0;
+
+  record->section = section;
+  record->size = size;
+  record->crc = recordCrc(record);
+  sizes[section] = sizeof(RamBackupRecord) + size;
+  return offset + sizes[section];
+}
+
+static uint32_t writeSnapshot(uint32_t offset, uint32_t limit, uint16_t * sizes)
+{
+  for (unsigned section = 0; section < RAM_BACKUP_SECTIONS; section++) {
+    offset = writeSection(section, offset, limit, sizes);
+    if (!offset)
+      return 0;
+  }
+  return offset;
+}
+
 void rambackupWrite()
 {
   copyRadioData(&ramBackupUncompressed.radio, &g_eeGeneral);
   copyModelData(&ramBackupUncompressed.model, &g_model);
-  ramBackup->size = compress(ramBackup->data, sizeof(ramBackup->data),
-                             (const uint8_t *)&ramBackupUncompressed,
-                             sizeof(ramBackupUncompressed));
 
-  TRACE("RamBackupWrite sdsize=%d backupsize=%d rlcsize=%d",
-        sizeof(ModelData) + sizeof(RadioData),
-        sizeof(Backup::RamBackupUncompressed), ramBackup->size);
+  uint32_t begin, end;
+  bool logValid = getLog(ramBackup->log, begin, end);
+  bool valid = logValid && sectionsLog == ramBackup->log;
+
+  uint32_t hashes[RAM_BACKUP_SECTIONS];
+  uint16_t sizes[RAM_BACKUP_SECTIONS];
+  uint8_t changed[RAM_BACKUP_SECTIONS];
+  unsigned count = 0;
+  uint32_t snapshotSize = 0;
+
+  for (unsigned section = 0; section < RAM_BACKUP_SECTIONS; section++) {
+    hashes[section] = sectionHash(section);
+    sizes[section] = sectionSizes[section];
+    snapshotSize += sizes[section];
+    if (!valid || hashes[section] != sectionHashes[section]) {
+      changed[count++] = section;
+    }
+  }
+
+  if (count == 0)
+    return;
+
+  uint32_t newBegin = 0, newEnd = 0;
+  if (valid) {
+    // append the changed sections, keeping room for a complete snapshot
+    // either before or after the log
+    uint32_t reserve = snapshotSize + snapshotSize / 4;
+    uint32_t limit = sizeof(ramBackup->data);
+    if (begin < reserve)
+      limit = (limit > reserve ? limit - reserve : 0);
+    newBegin = begin;
+    newEnd = end;
+    for (unsigned i = 0; i < count && newEnd; i++) {
+      newEnd = writeSection(changed[i], newEnd, limit, sizes);
+    }
+  }
+
+  if (!newEnd && logValid) {
+    // full log: new snapshot after the committed records, or before them
+    newBegin = end;
+    newEnd = writeSnapshot(end, sizeof(ramBackup->data), sizes);
+    if (!newEnd) {
+      newBegin = 0;
+      newEnd = writeSnapshot(0, begin, sizes);
+    }
+  }
+
+  if (!newEnd) {
+    TRACE("RamBackupWrite rewriting whole log");
+    setLog(0, 0);
+    newBegin = 0;
+    newEnd = writeSnapshot(0, sizeof(ramBackup->data), sizes);
+    if (!newEnd) {
+      TRACE("RamBackupWrite error: backup too big");
+      return;
+    }
+  }
+
+  setLog(newBegin, newEnd);
+  memcpy(sectionHashes, hashes, sizeof(sectionHashes));
+  memcpy(sectionSizes, sizes, sizeof(sectionSizes));
+
+  TRACE("RamBackupWrite sections=%d/%d log=%d-%d", count, RAM_BACKUP_SECTIONS,
+        newBegin, newEnd);
 }
 
 bool rambackupRestore()
 {
-  if (ramBackup->size == 0)
+  uint32_t begin, end;
+  if (!getLog(ramBackup->log, begin, end))
     return false;
 
-  if (uncompress((uint8_t *)&ramBackupUncompressed, sizeof(ramBackupUncompressed), ramBackup->data, ramBackup->size) != sizeof(ramBackupUncompressed))
-    return false;
+  bool restored[RAM_BACKUP_SECTIONS] = {false};
+  uint32_t offset = begin;
+  while (offset < end) {
+    if (offset + sizeof(RamBackupRecord) > end)
+      return false;
+
+    auto record = (const RamBackupRecord *)&ramBackup->data[offset];
+    offset += sizeof(RamBackupRecord) + record->size;
+    if (record->section >= RAM_BACKUP_SECTIONS || offset > end ||
+        record->crc != recordCrc(record))
+      return false;
+
+    if (uncompress(sectionData(record->section), sectionLength(record->section),
+                   (const uint8_t *)(record + 1),
+                   record->size) != sectionLength(record->section))
+      return false;
+
+    restored[record->section] = true;
+  }
+
+  for (unsigned section = 0; section < RAM_BACKUP_SECTIONS; section++) {
+    if (!restored[section])
+      return false;
+  }
 
   memset(&g_eeGeneral, 0, sizeof(g_eeGeneral));
   memset(&g_model, 0, sizeof(g_model));
@@ -24,9 +24,28 @@
 
 #include "definitions.h"
 
-PACK(struct RamBackup {
+// The backed up data is split into sections which are RLC compressed
+// separately. The backup RAM holds a log of section records, a write
+// only appends the sections which changed since the previous one.
+//
+// The records between the begin and end offsets are the committed ones,
+// both offsets are updated with a single 32 bit store once the new records
+// are written, so that a write interrupted by a reset leaves the previous
+// backup intact. When the log is full, a complete snapshot is written
+// after the committed records, or before them. Only when two snapshots
+// do not fit any more, it is written in place, which is not safe against
+// interrupted writes.
+#define RAM_BACKUP_SECTION_SIZE  512
+
+PACK(struct RamBackupRecord {
+  uint8_t section;
   uint16_t size;
-  uint8_t data[4094];
+  uint16_t crc;
+});
+
+PACK(struct RamBackup {
+  uint32_t log;  // begin offset | end offset << 16
+  uint8_t data[4092];
 });
 
 extern RamBackup * ramBackup;
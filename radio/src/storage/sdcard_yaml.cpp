@@ -142,22 +142,50 @@ const char * loadRadioSettings()
     return error;
 }
 
+// the small chunks generated are written to the file in batches
+#if defined(COLORLCD)
+  #define YAML_WRITER_BUFFER_SIZE  FF_MAX_SS
+#else
+  #define YAML_WRITER_BUFFER_SIZE  128
+#endif
+
 struct yaml_writer_ctx {
     FIL*    file;
     FRESULT result;
+    UINT    len;
+    char    buffer[YAML_WRITER_BUFFER_SIZE];
 };
 
-static bool yaml_writer(void* opaque, const char* str, size_t len)
+static bool yaml_writer_flush(yaml_writer_ctx* ctx)
 {
     UINT bytes_written;
+    UINT len = ctx->len;
+    ctx->len = 0;
+
+    ctx->result = f_write(ctx->file, ctx->buffer, len, &bytes_written);
+    return (ctx->result == FR_OK) && (bytes_written == len);
+}
+
+static bool yaml_writer(void* opaque, const char* str, size_t len)
+{
     yaml_writer_ctx* ctx = (yaml_writer_ctx*)opaque;
 
 #if defined(DEBUG_YAML)
     TRACE_NOCRLF("%.*s",len,str);
 #endif
 
-    ctx->result = f_write(ctx->file, str, len, &bytes_written);
-    return (ctx->result == FR_OK) && (bytes_written == len);
+    while (len > 0) {
+        size_t chunk = min<size_t>(len, sizeof(ctx->buffer) - ctx->len);
+        memcpy(ctx->buffer + ctx->len, str, chunk);
+        ctx->len += chunk;
+        str += chunk;
+        len -= chunk;
+
+        if (ctx->len == sizeof(ctx->buffer) && !yaml_writer_flush(ctx))
+            return false;
+    }
+
+    return true;
 }
 
 const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data)
@@ -175,8 +203,14 @@ const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t*
     yaml_writer_ctx ctx;
     ctx.file = &file;
     ctx.result = FR_OK;
+    ctx.len = 0;
     
-    if (!tree.generate(yaml_writer, &ctx)) {
+    bool generated = tree.generate(yaml_writer, &ctx);
+    if (ctx.result == FR_OK) {
+        generated = yaml_writer_flush(&ctx) && generated;
+    }
+
+    if (!generated) {
         if (ctx.result != FR_OK) {
             f_close(&file);
             return SDCARD_ERROR(ctx.result);
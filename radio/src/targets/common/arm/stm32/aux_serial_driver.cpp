@@ -143,6 +143,7 @@ static etx_serial_callbacks_t auxSerialCb = {
   .on_send = auxSerialOnSend,
   .on_receive = nullptr,
   .on_error = nullptr,
+  .on_idle = nullptr,
 };
 
 static void* auxSerialInit(const etx_serial_init* params)
@@ -168,6 +169,12 @@ static void aux1SetRxCb(void*, void (*cb)(uint8_t*, uint32_t))
   }
 }
 
+static void aux1SetIdleCb(void*, void (*cb)())
+{
+  auxSerialCb.on_idle = cb;
+  stm32_usart_enable_idle_irq(&auxUSART, cb != nullptr);
+}
+
 const etx_serial_driver_t AuxSerialDriver = {
   .init = auxSerialInit,
   .deinit = aux_serial_deinit,
@@ -178,6 +185,7 @@ const etx_serial_driver_t AuxSerialDriver = {
   .getBaudrate = nullptr,
   .setReceiveCb = aux1SetRxCb,
   .setBaudrateCb = nullptr,
+  .setIdleCb = aux1SetIdleCb,
 };
 
 extern "C" void AUX_SERIAL_USART_IRQHandler(void)
@@ -231,6 +239,7 @@ static etx_serial_callbacks_t aux2SerialCb = {
   .on_send = aux2SerialOnSend,
   .on_receive = nullptr,
   .on_error = nullptr,
+  .on_idle = nullptr,
 };
 
 static void* aux2SerialInit(const etx_serial_init* params)
@@ -256,6 +265,12 @@ static void aux2SetRxCb(void*, void (*cb)(uint8_t*, uint32_t))
   }
 }
 
+static void aux2SetIdleCb(void*, void (*cb)())
+{
+  aux2SerialCb.on_idle = cb;
+  stm32_usart_enable_idle_irq(&aux2USART, cb != nullptr);
+}
+
 extern "C" void AUX2_SERIAL_USART_IRQHandler(void)
 {
   DEBUG_INTERRUPT(INT_SER2);
@@ -272,6 +287,7 @@ const etx_serial_driver_t Aux2SerialDriver = {
   .getBaudrate = nullptr,
   .setReceiveCb = aux2SetRxCb,
   .setBaudrateCb = nullptr,
+  .setIdleCb = aux2SetIdleCb,
 };
 
 #endif // AUX2_SERIAL
@@ -156,6 +156,7 @@ const etx_serial_driver_t ExtmoduleSerialDriver = {
   .getBaudrate = nullptr,
   .setReceiveCb = nullptr,
   .setBaudrateCb = nullptr,
+  .setIdleCb = nullptr,
 };
 
 extern "C" void EXTMODULE_USART_IRQHandler(void)
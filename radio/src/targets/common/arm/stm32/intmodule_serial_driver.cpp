@@ -216,4 +216,5 @@ const etx_serial_driver_t IntmoduleSerialDriver = {
   .getBaudrate = nullptr,
   .setReceiveCb = nullptr,
   .setBaudrateCb = nullptr,
+  .setIdleCb = nullptr,
 };
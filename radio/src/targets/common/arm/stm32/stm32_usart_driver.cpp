@@ -65,6 +65,16 @@ void stm32_usart_deinit_rx_dma(const stm32_usart_t* usart)
   NVIC_EnableIRQ(usart->IRQn);
 }
 
+void stm32_usart_enable_idle_irq(const stm32_usart_t* usart, bool enable)
+{
+  if (enable) {
+    LL_USART_ClearFlag_IDLE(usart->USARTx);
+    LL_USART_EnableIT_IDLE(usart->USARTx);
+  } else {
+    LL_USART_DisableIT_IDLE(usart->USARTx);
+  }
+}
+
 void stm32_usart_init(const stm32_usart_t* usart, const etx_serial_init* params)
 {
   LL_USART_DeInit(usart->USARTx);
@@ -226,6 +236,12 @@ void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
 {
   uint32_t status = LL_USART_ReadReg(usart->USARTx, SR);
 
+  // IDLE is cleared by reading SR then DR, which the RX drain
+  // below does already: it has to be sampled before
+  bool idle = LL_USART_IsEnabledIT_IDLE(usart->USARTx) &&
+              (status & LL_USART_SR_IDLE);
+  bool rx_read = false;
+
   // Receive: do it first as it is more time critical
   if (LL_USART_IsEnabledIT_RXNE(usart->USARTx)) {
 
@@ -234,6 +250,7 @@ void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
 
       // This will clear the RXNE bit in USART_DR register
       uint8_t data = LL_USART_ReadReg(usart->USARTx, DR);
+      rx_read = true;
 
       if (status & USART_FLAG_ERRORS) {
         if (cb->on_error)
@@ -248,6 +265,14 @@ void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
     }
   }
 
+  // Idle line: end of frame
+  if (idle) {
+    if (!rx_read)
+      LL_USART_ClearFlag_IDLE(usart->USARTx);
+    if (cb->on_idle)
+      cb->on_idle();
+  }
+
   // IRQ based send: TXE IRQ is enabled only during transfer
   if (LL_USART_IsEnabledIT_TXE(usart->USARTx) && (status & LL_USART_SR_TXE)) {
 
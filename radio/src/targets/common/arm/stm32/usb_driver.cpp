@@ -76,6 +76,9 @@ void usbInit()
 }
 
 extern void usbInitLUNs();
+#if !defined(BOOT)
+static void usbJoystickRestart();
+#endif
 
 void usbStart()
 {
@@ -83,6 +86,7 @@ void usbStart()
 #if !defined(BOOT)
     case USB_JOYSTICK_MODE:
       // initialize USB as HID device
+      usbJoystickRestart();
       USBD_Init(&USB_OTG_dev, USB_OTG_FS_CORE_ID, &USR_desc, &USBD_HID_cb, &USR_cb);
       break;
 #endif
@@ -115,48 +119,101 @@ bool usbStarted()
 
 #if !defined(BOOT)
 #include "globals.h"
+#include "usb_joystick.h"
+
+#define USB_JOYSTICK_AXES     8
+#define USB_JOYSTICK_BUTTONS  24
+
+static_assert(USB_JOYSTICK_REPORT_SIZE(USB_JOYSTICK_AXES, USB_JOYSTICK_BUTTONS) == HID_IN_PACKET,
+              "HID report size mismatch");
+
+// The report being sent, and the next one, written by the mixer task while
+// the other is on the bus
+static uint8_t usbJoystickReports[2][HID_IN_PACKET];
+static volatile uint8_t usbJoystickSending = 0;
+static volatile bool usbJoystickPending = false;
+static uint8_t usbJoystickLastReport[HID_IN_PACKET];
+
+#if defined(JITTER_MEASURE)
+JitterMeter<uint16_t> usbJoystickLatency;
+JitterMeter<uint16_t> usbJoystickInterval;
+static uint16_t usbJoystickReportTime;
+static uint16_t usbJoystickSentTime;
+static tmr10ms_t usbJoystickJitterResetTime = 0;
+#endif
+
+// Called with the USB interrupt masked or from it
+static void usbJoystickSendPending()
+{
+  if (usbJoystickPending && USBD_HID_SendReport(&USB_OTG_dev, 0, 0) == USBD_OK) {
+    usbJoystickPending = false;
+    usbJoystickSending ^= 1;
+    USBD_HID_SendReport(&USB_OTG_dev, usbJoystickReports[usbJoystickSending], HID_IN_PACKET);
+#if defined(JITTER_MEASURE)
+    uint16_t now = getTmr2MHz();
+    usbJoystickLatency.measure(now - usbJoystickReportTime);
+    usbJoystickInterval.measure(now - usbJoystickSentTime);
+    usbJoystickSentTime = now;
+#endif
+  }
+}
+
+// The previous report has been sent, the next one goes on the bus at the
+// following host poll rather than at the next mixer cycle
+extern "C" void usbJoystickReportSent()
+{
+  usbJoystickSendPending();
+}
+
+static void usbJoystickRestart()
+{
+  // the first report is sent even if the outputs do not move
+  memset(usbJoystickLastReport, 0xFF, HID_IN_PACKET);
+  usbJoystickPending = false;
+}
 
 /*
-  Prepare and send new USB data packet
+  Prepare the USB report from the mixer outputs, called by the mixer task each
+  time they are updated. Unchanged reports are not sent.
 
-  The format of HID_Buffer is defined by
-  USB endpoint description can be found in
-  file usb_hid_joystick.c, variable HID_JOYSTICK_ReportDesc
+  The format of the report is defined by the HID_JOYSTICK_ReportDesc variable
+  in file usbd_hid_joystick.c:
+  - channels 9-32 are the buttons
+  - channels 1-8 are the axes
 */
 void usbJoystickUpdate()
 {
-  static uint8_t HID_Buffer[HID_IN_PACKET];
-
-  // test to se if TX buffer is free
-  if (USBD_HID_SendReport(&USB_OTG_dev, 0, 0) == USBD_OK) {
-    //buttons
-    HID_Buffer[0] = 0;
-    HID_Buffer[1] = 0;
-    HID_Buffer[2] = 0;
-    for (int i = 0; i < 8; ++i) {
-      if ( channelOutputs[i+8] > 0 ) {
-        HID_Buffer[0] |= (1 << i);
-      }
-      if ( channelOutputs[i+16] > 0 ) {
-        HID_Buffer[1] |= (1 << i);
-      }
-      if ( channelOutputs[i+24] > 0 ) {
-        HID_Buffer[2] |= (1 << i);
-      }
-    }
-
-    //analog values
-    //uint8_t * p = HID_Buffer + 1;
-    for (int i = 0; i < 8; ++i) {
-
-      int16_t value = channelOutputs[i] + 1024;
-      if ( value > 2047 ) value = 2047;
-      else if ( value < 0 ) value = 0;
-      HID_Buffer[i*2 +3] = static_cast<uint8_t>(value & 0xFF);
-      HID_Buffer[i*2 +4] = static_cast<uint8_t>((value >> 8) & 0x07);
-
-    }
-    USBD_HID_SendReport(&USB_OTG_dev, HID_Buffer, HID_IN_PACKET);
+  uint8_t report[HID_IN_PACKET];
+  usbJoystickPackReport(report, &channelOutputs[0], USB_JOYSTICK_AXES,
+                        &channelOutputs[USB_JOYSTICK_AXES], USB_JOYSTICK_BUTTONS);
+
+#if defined(JITTER_MEASURE)
+  if (usbJoystickJitterResetTime < get_tmr10ms()) {
+    // reset jitter measurement every second
+    usbJoystickLatency.reset();
+    usbJoystickInterval.reset();
+    usbJoystickJitterResetTime = get_tmr10ms() + 100;
+  }
+#endif
+
+  if (memcmp(report, usbJoystickLastReport, HID_IN_PACKET)) {
+    memcpy(usbJoystickLastReport, report, HID_IN_PACKET);
+
+    // the report not being sent is free once the pending flag is cleared
+    NVIC_DisableIRQ(OTG_FS_IRQn);
+    usbJoystickPending = false;
+    NVIC_EnableIRQ(OTG_FS_IRQn);
+
+    memcpy(usbJoystickReports[usbJoystickSending ^ 1], report, HID_IN_PACKET);
+#if defined(JITTER_MEASURE)
+    usbJoystickReportTime = getTmr2MHz();
+#endif
+    usbJoystickPending = true;
   }
+
+  // still pending when the device was not configured yet
+  NVIC_DisableIRQ(OTG_FS_IRQn);
+  usbJoystickSendPending();
+  NVIC_EnableIRQ(OTG_FS_IRQn);
 }
 #endif
@@ -56,3 +56,10 @@ void setSelectedUsbMode(int mode);
 EXTERN_C(uint32_t usbSerialFreeSpace());
 
 extern const etx_serial_port_t UsbSerialPort;
+
+#if defined(JITTER_MEASURE) && defined(__cplusplus)
+#include "debug.h"
+// Joystick reports, from the mixer output to the bus, in 0.5us
+extern JitterMeter<uint16_t> usbJoystickLatency;
+extern JitterMeter<uint16_t> usbJoystickInterval;
+#endif
@@ -307,6 +307,7 @@ static const etx_serial_driver_t usbSerialDriver = {
   .getBaudrate = usbSerialBaudRate,
   .setReceiveCb = usbSerialSetReceiveDataCb,
   .setBaudrateCb = usbSerialSetBaudRateCb,
+  .setIdleCb = nullptr,
 };
 
 const etx_serial_port_t UsbSerialPort = {
@@ -49,6 +49,12 @@
 #define HID_OUT_EP                   0x01
 
 #define HID_IN_PACKET                19
+// Joystick reports polling interval (ms), 1 is the full speed minimum
+#if defined(USB_JOYSTICK_INTERVAL)
+#define HID_IN_INTERVAL              USB_JOYSTICK_INTERVAL
+#else
+#define HID_IN_INTERVAL              1
+#endif
 #define HID_OUT_PACKET               9
 
 #define CDC_IN_EP                    0x81  /* EP1 for data IN */
@@ -77,6 +77,9 @@ static uint8_t  USBD_HID_Setup (void  *pdev,
 static const uint8_t  *USBD_HID_GetCfgDesc (uint8_t speed, uint16_t *length);
 
 static uint8_t  USBD_HID_DataIn (void  *pdev, uint8_t epnum);
+
+// queues the next report, see usb_driver.cpp
+void usbJoystickReportSent(void);
 /**
   * @}
   */ 
@@ -236,7 +239,7 @@ __ALIGN_BEGIN static const uint8_t USBD_HID_CfgDesc[USB_HID_CONFIG_DESC_SIZ] __A
   0x03,          /*bmAttributes: Interrupt endpoint*/
   HID_IN_PACKET, /*wMaxPacketSize: 4 Byte max */
   0x00,
-  0x01,          /*bInterval: Polling Interval (1 ms)*/
+  HID_IN_INTERVAL, /*bInterval: Polling Interval (ms)*/
   /* 34 */
 } ;
 
@@ -435,6 +438,7 @@ static uint8_t  USBD_HID_DataIn (void  *pdev,
   /* Ensure that the FIFO is empty before a new transfer, this condition could 
   be caused by  a new transfer before the end of the previous transfer */
   DCD_EP_Flush(pdev, HID_IN_EP);
+  usbJoystickReportSent();
   return USBD_OK;
 }
 
@@ -78,6 +78,7 @@ const etx_serial_driver_t IntmoduleSerialDriver = {
     .getBaudrate = nullptr,
     .setReceiveCb = nullptr,
     .setBaudrateCb = nullptr,
+    .setIdleCb = nullptr,
 };
 
 const etx_serial_driver_t ExtmoduleSerialDriver = {
@@ -91,4 +92,5 @@ const etx_serial_driver_t ExtmoduleSerialDriver = {
     .getBaudrate = nullptr,
     .setReceiveCb = nullptr,
     .setBaudrateCb = nullptr,
+    .setIdleCb = nullptr,
 };
@@ -25,6 +25,8 @@
 
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QMetaMethod>
+#include <QThread>
 
 #if !defined(MAX_LOGICAL_SWITCHES) && defined(NUM_CSW)
   #define MAX_LOGICAL_SWITCHES    NUM_CSW
@@ -66,7 +68,9 @@ OpenTxSimulator::OpenTxSimulator() :
   SimulatorInterface(),
   m_timer10ms(nullptr),
   m_resetOutputsData(true),
-  m_stopRequested(false)
+  m_stopRequested(false),
+  m_outputsCount(0),
+  m_outputsSequence(0)
 {
   tracebackDevices.clear();
   traceCallback = firmwareTraceCb;
@@ -497,8 +501,10 @@ void OpenTxSimulator::run()
 
   checkLcdChanged();
 
+  publishOutputs();
+
   if (!(loops % 5)) {
-    checkOutputsChanged();
+    emitOutputsChanged();
   }
 
   if (!(loops % (SIMULATOR_INTERFACE_HEARTBEAT_PERIOD / 10))) {
@@ -528,65 +534,57 @@ bool OpenTxSimulator::checkLcdChanged()
   return false;
 }
 
-void OpenTxSimulator::checkOutputsChanged()
+void OpenTxSimulator::publishOutputs()
 {
-  static TxOutputs lastOutputs;
-  static size_t chansDim = DIM(channelOutputs);
+  const TxOutputs & last = m_outputs[m_outputsCount & 1].outputs;
+  TxOutputsSnapshot & next = m_outputs[(m_outputsCount + 1) & 1];
+  TxOutputs & out = next.outputs;
+  const bool reset = m_resetOutputsData || !m_outputsCount;
   const static int16_t limit = 512 * 2;
-  qint32 tmpVal;
   uint8_t i, idx;
   const uint8_t phase = getFlightMode();  // opentx.cpp
   const uint8_t mode = getStickMode();
 
-  for (i=0; i < chansDim; i++) {
-    if (lastOutputs.chans[i] != channelOutputs[i] || m_resetOutputsData) {
-      emit channelOutValueChange(i, channelOutputs[i], (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit));
-      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, channelOutputs[i]);
-      lastOutputs.chans[i] = channelOutputs[i];
-    }
-    if (lastOutputs.ex_chans[i] != ex_chans[i] || m_resetOutputsData) {
-      emit channelMixValueChange(i, ex_chans[i], limit * 2);
-      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, ex_chans[i]);
-      lastOutputs.ex_chans[i] = ex_chans[i];
-    }
+  static_assert(DIM(channelOutputs) <= 32, "chansChanged mask too small");
+  static_assert(MAX_LOGICAL_SWITCHES <= 64, "vswChanged mask too small");
+
+  next.chansChanged = next.exChansChanged = 0;
+  for (i=0; i < DIM(channelOutputs); i++) {
+    out.chans[i] = channelOutputs[i];
+    if (out.chans[i] != last.chans[i] || reset)
+      next.chansChanged |= (1u << i);
+    out.ex_chans[i] = ex_chans[i];
+    if (out.ex_chans[i] != last.ex_chans[i] || reset)
+      next.exChansChanged |= (1u << i);
   }
+  next.chanLimit = g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit;
 
+  next.vswChanged = 0;
   for (i=0; i < MAX_LOGICAL_SWITCHES; i++) {
-    tmpVal = (qint32)GET_SWITCH_BOOL(SWSRC_SW1+i);
-    if (lastOutputs.vsw[i] != (bool)tmpVal || m_resetOutputsData) {
-      emit virtualSwValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, tmpVal);
-      lastOutputs.vsw[i] = tmpVal;
-    }
+    out.vsw[i] = GET_SWITCH_BOOL(SWSRC_SW1+i);
+    if (out.vsw[i] != last.vsw[i] || reset)
+      next.vswChanged |= (1ull << i);
   }
 
+  next.trimsChanged = 0;
   for (i=0; i < Board::TRIM_AXIS_COUNT; i++) {
     if (i < 4)  // swap axes
       idx = modn12x3[4 * mode + i];
     else
       idx = i;
 
-    tmpVal = getTrimValue(getTrimFlightMode(phase, idx), idx);
-    if (lastOutputs.trims[i] != tmpVal || m_resetOutputsData) {
-      emit trimValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, tmpVal);
-      lastOutputs.trims[i] = tmpVal;
-    }
+    out.trims[i] = getTrimValue(getTrimFlightMode(phase, idx), idx);
+    if (out.trims[i] != last.trims[i] || reset)
+      next.trimsChanged |= (1u << i);
   }
 
-  tmpVal = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
-  if (lastOutputs.trimRange != tmpVal || m_resetOutputsData) {
-    emit trimRangeChange(Board::TRIM_AXIS_COUNT, -tmpVal, tmpVal);
-    emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, Board::TRIM_AXIS_COUNT, tmpVal);
-    lastOutputs.trimRange = tmpVal;
-  }
+  out.trimRange = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
+  next.trimRangeChanged = (out.trimRange != last.trimRange || reset);
 
-  if (lastOutputs.phase != phase || m_resetOutputsData) {
-    emit phaseChanged(phase, getCurrentPhaseName());
-    emit outputValueChange(OUTPUT_SRC_PHASE, 0, qint16(phase));
-    lastOutputs.phase = phase;
-  }
+  out.phase = phase;
+  next.phaseChanged = (out.phase != last.phase || reset);
 
+  memset(next.gvarsChanged, 0, sizeof(next.gvarsChanged));
 #if defined(GVAR_VALUE) && defined(GVARS)
   gVarMode_t gvar;
   for (uint8_t gv=0; gv < MAX_GVARS; gv++) {
@@ -595,16 +593,118 @@ void OpenTxSimulator::checkOutputsChanged()
     for (uint8_t fm=0; fm < MAX_FLIGHT_MODES; fm++) {
       gvar.mode = fm;
       gvar.value = (int16_t)GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
-      tmpVal = gvar;
-      if (lastOutputs.gvars[fm][gv] != tmpVal || m_resetOutputsData) {
-        lastOutputs.gvars[fm][gv] = tmpVal;
-        emit gVarValueChange(gv, tmpVal);
-        emit outputValueChange(OUTPUT_SRC_GVAR, gv, tmpVal);
+      out.gvars[fm][gv] = gvar;
+      if (out.gvars[fm][gv] != last.gvars[fm][gv] || reset)
+        next.gvarsChanged[fm] |= (1 << gv);
+    }
+  }
+#endif
+
+  next.sequence = ++m_outputsCount;
+
+  // odd while the published copy is written: only this thread writes it
+  const quint32 seq = m_outputsSequence.load(std::memory_order_relaxed);
+  m_outputsSequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  m_publishedOutputs = next;
+  m_outputsSequence.store(seq + 2, std::memory_order_release);
+}
+
+bool OpenTxSimulator::getOutputsSnapshot(TxOutputsSnapshot & snapshot)
+{
+  // retry while the copy is being written (odd sequence)
+  // or if it was written again during our copy
+  for (;;) {
+    const quint32 seq = m_outputsSequence.load(std::memory_order_acquire);
+    if (!seq)
+      return false;
+    if (seq & 1) {
+      QThread::yieldCurrentThread();
+      continue;
+    }
+    snapshot = m_publishedOutputs;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_outputsSequence.load(std::memory_order_relaxed) == seq)
+      return true;
+  }
+}
+
+// Per-value signals, for the widgets not using the snapshots: emitted every
+// 5 cycles as before, for the values changed since the last emission
+void OpenTxSimulator::emitOutputsChanged()
+{
+  const TxOutputsSnapshot & snapshot = m_outputs[m_outputsCount & 1];
+  const TxOutputs & out = snapshot.outputs;
+  TxOutputs & last = m_emittedOutputs;
+  const bool reset = m_resetOutputsData;
+  const bool valueSignal = isSignalConnected(QMetaMethod::fromSignal(&SimulatorInterface::outputValueChange));
+  const bool chanOutSignal = isSignalConnected(QMetaMethod::fromSignal(&SimulatorInterface::channelOutValueChange));
+  const bool chanMixSignal = isSignalConnected(QMetaMethod::fromSignal(&SimulatorInterface::channelMixValueChange));
+  const bool vswSignal = isSignalConnected(QMetaMethod::fromSignal(&SimulatorInterface::virtualSwValueChange));
+  const bool gvarSignal = isSignalConnected(QMetaMethod::fromSignal(&SimulatorInterface::gVarValueChange));
+  const static int16_t limit = 512 * 2;
+  uint8_t i;
+
+  for (i=0; i < DIM(channelOutputs); i++) {
+    if (out.chans[i] != last.chans[i] || reset) {
+      if (chanOutSignal)
+        emit channelOutValueChange(i, out.chans[i], snapshot.chanLimit);
+      if (valueSignal)
+        emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, out.chans[i]);
+    }
+    if (out.ex_chans[i] != last.ex_chans[i] || reset) {
+      if (chanMixSignal)
+        emit channelMixValueChange(i, out.ex_chans[i], limit * 2);
+      if (valueSignal)
+        emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, out.ex_chans[i]);
+    }
+  }
+
+  for (i=0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (out.vsw[i] != last.vsw[i] || reset) {
+      if (vswSignal)
+        emit virtualSwValueChange(i, out.vsw[i]);
+      if (valueSignal)
+        emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, out.vsw[i]);
+    }
+  }
+
+  for (i=0; i < Board::TRIM_AXIS_COUNT; i++) {
+    if (out.trims[i] != last.trims[i] || reset) {
+      emit trimValueChange(i, out.trims[i]);
+      if (valueSignal)
+        emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, out.trims[i]);
+    }
+  }
+
+  if (out.trimRange != last.trimRange || reset) {
+    emit trimRangeChange(Board::TRIM_AXIS_COUNT, -out.trimRange, out.trimRange);
+    if (valueSignal)
+      emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, Board::TRIM_AXIS_COUNT, out.trimRange);
+  }
+
+  if (out.phase != last.phase || reset) {
+    emit phaseChanged(out.phase, getCurrentPhaseName());
+    if (valueSignal)
+      emit outputValueChange(OUTPUT_SRC_PHASE, 0, qint16(out.phase));
+  }
+
+#if defined(GVAR_VALUE) && defined(GVARS)
+  for (uint8_t gv=0; gv < MAX_GVARS; gv++) {
+    for (uint8_t fm=0; fm < MAX_FLIGHT_MODES; fm++) {
+      if (out.gvars[fm][gv] != last.gvars[fm][gv] || reset) {
+        if (gvarSignal)
+          emit gVarValueChange(gv, out.gvars[fm][gv]);
+        if (valueSignal)
+          emit outputValueChange(OUTPUT_SRC_GVAR, gv, out.gvars[fm][gv]);
       }
     }
   }
+#else
+  (void)gvarSignal;
 #endif
 
+  last = out;
   m_resetOutputsData = false;
 }
 
@@ -28,6 +28,8 @@
 #include <QObject>
 #include <QTimer>
 
+#include <atomic>
+
 #if defined __GNUC__
   #define DLLEXPORT
 #else
@@ -56,6 +58,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0);
     virtual uint16_t getSensorRatio(uint16_t id);
     virtual const int getCapability(Capability cap);
+    virtual bool getOutputsSnapshot(TxOutputsSnapshot & snapshot);
 
     static QVector<QIODevice *> tracebackDevices;
 
@@ -91,7 +94,8 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     bool isStopRequested();
     void setStopRequested(bool stop);
     bool checkLcdChanged();
-    void checkOutputsChanged();
+    void publishOutputs();
+    void emitOutputsChanged();
     uint8_t getStickMode();
     const char * getPhaseName(unsigned int phase);
     const QString getCurrentPhaseName();
@@ -110,6 +114,16 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     bool m_resetOutputsData;
     bool m_stopRequested;
 
+    // simulator thread only: m_outputs[m_outputsCount & 1] is the last
+    // snapshot built, the other one the previous, to find the changes
+    TxOutputsSnapshot m_outputs[2];
+    quint32 m_outputsCount;
+    TxOutputs m_emittedOutputs;
+
+    // seqlock: m_publishedOutputs is being written while the sequence is odd
+    TxOutputsSnapshot m_publishedOutputs;
+    std::atomic<quint32> m_outputsSequence;
+
 };
 
 #endif // _OPENTX_SIMULATOR_H_
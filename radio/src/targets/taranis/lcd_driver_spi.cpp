@@ -47,6 +47,24 @@
 bool lcdInitFinished = false;
 void lcdInitFinish();
 
+#if LCD_W == 128
+#if !defined(LCD_VERTICAL_INVERT)
+  #define LCD_COLUMN_OFFSET            4
+#elif defined(LCD_W_OFFSET)
+  #define LCD_COLUMN_OFFSET            LCD_W_OFFSET
+#else
+  #define LCD_COLUMN_OFFSET            0
+#endif
+
+// What the LCD shows. The DMA transfers are done from there, so that
+// displayBuf may be drawn again while they are running.
+static pixel_t lcdShadowBuf[DISPLAY_BUFFER_SIZE] __DMA;
+static LcdSpan lcdSpans[(LCD_H + 7) / 8];
+static uint8_t lcdSpansCount;
+static uint8_t lcdSpanIndex;
+static bool lcdFullRefresh = true;
+#endif
+
 void lcdWriteCommand(uint8_t byte)
 {
   LCD_A0_LOW();
@@ -114,6 +132,8 @@ void lcdHardwareInit()
 #if LCD_W == 128
 void lcdStart()
 {
+  lcdFullRefresh = true;
+
 #if defined(LCD_VERTICAL_INVERT)
   // T12 and TX12 have the screen inverted.
   lcdWriteCommand(0xe2); // (14) Soft reset
@@ -199,6 +219,26 @@ void lcdWriteAddress(uint8_t x, uint8_t y)
 
 volatile bool lcd_busy;
 
+#if LCD_W == 128
+static void lcdSendSpan(const LcdSpan & span)
+{
+  uint8_t column = LCD_COLUMN_OFFSET + span.start;
+  lcdWriteCommand(0x10 | (column >> 4)); // Column addr MSB
+  lcdWriteCommand(column & 0x0F); // Column addr LSB
+  lcdWriteCommand(0xB0 | span.page); // Page addr
+
+  LCD_NCS_LOW();
+  LCD_A0_HIGH();
+
+  LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
+  LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
+  LCD_DMA_Stream->M0AR = (uint32_t)&lcdShadowBuf[span.page * LCD_W + span.start];
+  LCD_DMA_Stream->NDTR = span.length;
+  LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
+  LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
+}
+#endif
+
 #if !defined(LCD_DUAL_BUFFER)
 void lcdRefreshWait()
 {
@@ -213,31 +253,17 @@ void lcdRefresh(bool wait)
   }
 
 #if LCD_W == 128
-  uint8_t * p = displayBuf;
-#if defined(LCD_W_OFFSET)
-  lcdWriteCommand(LCD_W_OFFSET);
-#endif
-  for (uint8_t y=0; y < 8; y++, p+=LCD_W) {
-    lcdWriteCommand(0x10); // Column addr 0
-    lcdWriteCommand(0xB0 | y); // Page addr y
-#if !defined(LCD_VERTICAL_INVERT)
-    lcdWriteCommand(0x04);
-#endif
-
-    LCD_NCS_LOW();
-    LCD_A0_HIGH();
+  // Wait if previous DMA transfer still active
+  WAIT_FOR_DMA_END();
 
+  // only the changed parts of the pages are sent, one after the other
+  // from the DMA interrupt
+  lcdSpansCount = lcdGetRefreshSpans(lcdShadowBuf, lcdSpans, lcdFullRefresh);
+  lcdFullRefresh = false;
+  if (lcdSpansCount > 0) {
     lcd_busy = true;
-    LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
-    LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
-    LCD_DMA_Stream->M0AR = (uint32_t)p;
-    LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
-    LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
-
-    WAIT_FOR_DMA_END();
-
-    LCD_NCS_HIGH();
-    LCD_A0_HIGH();
+    lcdSpanIndex = 0;
+    lcdSendSpan(lcdSpans[0]);
   }
 #else
   // Wait if previous DMA transfer still active
@@ -279,6 +305,14 @@ extern "C" void LCD_DMA_Stream_IRQHandler()
     */
   }
   LCD_NCS_HIGH();
+
+#if LCD_W == 128
+  if (++lcdSpanIndex < lcdSpansCount) {
+    lcdSendSpan(lcdSpans[lcdSpanIndex]);
+    return;
+  }
+#endif
+
   lcd_busy = false;
 }
 
@@ -376,9 +410,7 @@ void lcdSetRefVolt(uint8_t val)
     lcdInitFinish();
   }
 
-#if LCD_W != 128
   WAIT_FOR_DMA_END();
-#endif
 
   lcdWriteCommand(0x81); // Set Vop
   lcdWriteCommand(val+LCD_CONTRAST_OFFSET); // 0-255
@@ -34,6 +34,7 @@ RTOS_DEFINE_STACK(audioStack, AUDIO_STACK_SIZE);
 
 RTOS_MUTEX_HANDLE audioMutex;
 RTOS_MUTEX_HANDLE mixerMutex;
+RTOS_MUTEX_HANDLE pulsesMutex;
 
 void stackPaint()
 {
@@ -145,13 +146,26 @@ TASK_FUNCTION(mixerTask)
       uint16_t t0 = getTmr2MHz();
 
       DEBUG_TIMER_START(debugTimerMixer);
+      DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
       RTOS_LOCK_MUTEX(mixerMutex);
+      DEBUG_TIMER_START(debugTimerMixerMutex);
 
       doMixerCalculations();
+
+      // channelOutputs is only written by evalMixes(), in this task: it stays
+      // as published until the next iteration, so the module frames are built
+      // from it without holding mixerMutex. pulsesMutex is taken before
+      // mixerMutex is released, see pauseMixerCalculations()
+      RTOS_LOCK_MUTEX(pulsesMutex);
+      DEBUG_TIMER_STOP(debugTimerMixerMutex);
+      RTOS_UNLOCK_MUTEX(mixerMutex);
+
       sendSynchronousPulses((1 << INTERNAL_MODULE) | (1 << EXTERNAL_MODULE));
-      doMixerPeriodicUpdates();
+      RTOS_UNLOCK_MUTEX(pulsesMutex);
+      DEBUG_TIMER_STOP(debugTimerMixerCalcToUsage);
 
-      DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
+      RTOS_LOCK_MUTEX(mixerMutex);
+      doMixerPeriodicUpdates();
       DEBUG_TIMER_SAMPLE(debugTimerMixerIterval);
       RTOS_UNLOCK_MUTEX(mixerMutex);
       DEBUG_TIMER_STOP(debugTimerMixer);
@@ -257,6 +271,7 @@ void tasksStart()
 {
   RTOS_CREATE_MUTEX(audioMutex);
   RTOS_CREATE_MUTEX(mixerMutex);
+  RTOS_CREATE_MUTEX(pulsesMutex);
 
 #if defined(CLI)
   cliStart();
@@ -50,6 +50,7 @@ extern RTOS_TASK_HANDLE menusTaskId;
 extern RTOS_DEFINE_STACK(menusStack, MENUS_STACK_SIZE);
 
 extern RTOS_MUTEX_HANDLE mixerMutex;
+extern RTOS_MUTEX_HANDLE pulsesMutex;
 extern RTOS_TASK_HANDLE mixerTaskId;
 extern RTOS_DEFINE_STACK(mixerStack, MIXER_STACK_SIZE);
 
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <cctype>
+#include <chrono>
+#include <string>
+#include "gtests.h"
+
+// Each result is printed and recorded as a property of the running test:
+//   bench-radio --gtest_output=xml:bench-radio.xml
+// gives a file which can be compared from one commit to another.
+
+#define BENCHMARK_ITERATIONS  2000
+
+template <typename Function>
+double nsPerIteration(Function function, int iterations = BENCHMARK_ITERATIONS)
+{
+  function();  // first run, e.g. a cache being filled
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    function();
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+inline void recordBenchmark(const std::string & name, double value, const char * unit = "ns")
+{
+  std::string key = name + "_" + unit;
+  for (char & c : key) {
+    if (!isalnum(c)) c = '_';
+  }
+
+  char text[16];
+  snprintf(text, sizeof(text), "%.2f", value);
+  testing::Test::RecordProperty(key, text);
+
+  printf("%-40s %12.2f %s\n", name.c_str(), value, unit);
+}
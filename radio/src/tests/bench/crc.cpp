@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+// CRC throughput of each table layout
+template <class Engine>
+static void benchmark(const char * name)
+{
+  static uint8_t buffer[4096];
+  for (unsigned i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = i * 7;
+  }
+
+  volatile unsigned result = 0;
+  double ns = nsPerIteration([&]() {
+    result = result + Engine::update(0, buffer, sizeof(buffer));
+  }, 1000);
+  recordBenchmark(name, sizeof(buffer) / ns * 1e3, "MB/s");
+}
+
+TEST(CrcBenchmark, engines)
+{
+  benchmark<CrcEngine<uint8_t, 0xD5>>("crc8 D5 x1");
+  benchmark<CrcEngine<uint8_t, 0xD5, false, 4>>("crc8 D5 x4");
+  benchmark<CrcEngine<uint8_t, 0xD5, false, 8>>("crc8 D5 x8");
+  benchmark<CrcEngine<uint8_t, 0xBA>>("crc8 BA x1");
+  benchmark<CrcEngine<uint8_t, 0xBA, false, 4>>("crc8 BA x4");
+  benchmark<CrcEngine<uint16_t, 0x1021, false>>("crc16 1021 x1");
+  benchmark<CrcEngine<uint16_t, 0x1021, false, 2>>("crc16 1021 x2");
+  benchmark<CrcEngine<uint16_t, 0x1021, false, 4>>("crc16 1021 x4");
+  benchmark<CrcEngine<uint16_t, 0x1021, false, 8>>("crc16 1021 x8");
+  benchmark<CrcEngine<uint16_t, 0x8408, true>>("crc16 1189 x1");
+  benchmark<CrcEngine<uint16_t, 0x8408, true, 2>>("crc16 1189 x2");
+  benchmark<CrcEngine<uint16_t, 0x8408, true, 4>>("crc16 1189 x4");
+  benchmark<CrcEngine<uint16_t, 0x8408, true, 8>>("crc16 1189 x8");
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+#if defined(PCBFRSKY)
+class SpecialFunctionsBenchmark : public OpenTxTest {};
+
+TEST_F(SpecialFunctionsBenchmark, evalFunctions)
+{
+  // 64 functions on 4 switches, half of them active
+  for (int i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    CustomFunctionData & cfn = g_model.customFn[i];
+    cfn.swtch = (i % 2 ? SWSRC_SA0 : SWSRC_SB0) + (i % 4 >= 2 ? 2 : 0);  // SB0, SA0, SB2, SA2
+    cfn.active = true;
+    switch (i % 4) {
+      case 0:
+        cfn.func = FUNC_TRAINER;
+        break;
+      case 1:
+        cfn.func = FUNC_RESET;
+        cfn.all.val = FUNC_RESET_FLIGHT;
+        break;
+      case 2:
+        cfn.func = FUNC_SET_TIMER;
+        cfn.all.param = 2;
+        break;
+      default:
+        cfn.func = FUNC_BACKLIGHT;
+        break;
+    }
+  }
+  simuSetSwitch(0, -1);
+  simuSetSwitch(1, -1);
+
+  recordBenchmark("evalFunctions", nsPerIteration([]() {
+    evalFunctions(g_model.customFn, modelFunctionsContext);
+  }, 10000));
+
+  EXPECT_TRUE(isFunctionActive(FUNCTION_TRAINER_STICK1));
+  EXPECT_FALSE(isFunctionActive(FUNCTION_BACKLIGHT));
+}
+#endif
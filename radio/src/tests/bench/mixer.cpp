@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+#if defined(SDCARD_YAML)
+#include "storage/sdcard_common.h"
+#endif
+
+// Each stage of the mixer is timed separately on the models below
+
+#define FADING_TIME           20  // 2s
+
+// Flight mode k > 0 is selected by one position of the first switches
+static uint8_t flightModeSwitch(int k)
+{
+  return ((k - 1) / 2) % NUM_SWITCHES;
+}
+
+static void selectFlightMode(int k)
+{
+  for (int m = 1; m < MAX_FLIGHT_MODES; m++) {
+    simuSetSwitch(flightModeSwitch(m), 0);
+  }
+  if (k > 0) {
+    simuSetSwitch(flightModeSwitch(k), k & 1 ? -1 : 1);
+  }
+}
+
+class MixerBenchmark : public OpenTxTest
+{
+  protected:
+    virtual void SetUp()
+    {
+      OpenTxTest::SetUp();
+      for (int i = 0; i < NUM_STICKS + NUM_POTS + NUM_SLIDERS; i++) {
+        anaInValues[i] = 512 + 100 * i;
+      }
+    }
+
+    // every input, mix, logical switch, curve, GVar and flight mode in use
+    static void setWorstCaseModel(uint8_t fadeTime)
+    {
+      for (int i = 0; i < MAX_CURVES && 5 * (i + 1) <= MAX_CURVE_POINTS; i++) {
+        g_model.curves[i].type = CURVE_TYPE_STANDARD;
+        g_model.curves[i].smooth = i & 1;
+        for (int j = 0; j < 5; j++) {
+          g_model.points[5 * i + j] = (j - 2) * (30 + i % 20);
+        }
+      }
+      loadCurves();
+
+      for (int i = 0; i < MAX_EXPOS; i++) {
+        ExpoData & expo = g_model.expoData[i];
+        expo.mode = 3;
+        expo.chn = i * MAX_INPUTS / MAX_EXPOS;
+        expo.srcRaw = MIXSRC_FIRST_STICK + i % NUM_STICKS;
+        expo.weight = 100 - i % 50;
+        expo.offset = i % 10;
+        expo.curve.type = CURVE_REF_CUSTOM;
+        expo.curve.value = 1 + i % MAX_CURVES;
+        expo.flightModes = (i % 3) ? 0 : 1 << (i % MAX_FLIGHT_MODES);
+      }
+
+      for (int i = 0; i < MAX_MIXERS; i++) {
+        MixData & mix = g_model.mixData[i];
+        mix.destCh = i * MAX_OUTPUT_CHANNELS / MAX_MIXERS;
+        mix.mltpx = MLTPX_ADD;
+        mix.weight = 100;
+        mix.flightModes = (i % 3) ? 0 : 1 << (i % MAX_FLIGHT_MODES);
+        switch (i % 4) {
+          case 0:
+            mix.srcRaw = MIXSRC_FIRST_INPUT + i % MAX_INPUTS;
+            mix.curve.type = CURVE_REF_CUSTOM;
+            mix.curve.value = 1 + i % MAX_CURVES;
+            break;
+          case 1:
+            mix.srcRaw = MIXSRC_FIRST_INPUT + i % MAX_INPUTS;
+#if defined(GVARS)
+            mix.weight = GV_CALC_VALUE_IDX_POS(i % MAX_GVARS, GV1_LARGE);
+#endif
+            mix.offset = 10;
+            break;
+          case 2:
+            mix.srcRaw = MIXSRC_FIRST_LOGICAL_SWITCH + i % MAX_LOGICAL_SWITCHES;
+            mix.swtch = SWSRC_FIRST_LOGICAL_SWITCH + (i + 1) % MAX_LOGICAL_SWITCHES;
+            mix.weight = 50;
+            break;
+          default:
+            mix.srcRaw = mix.destCh > 0 ? MIXSRC_CH1 + mix.destCh - 1 : MIXSRC_MAX;
+            mix.speedUp = 10;
+            mix.speedDown = 10;
+            mix.delayUp = 5;
+            mix.delayDown = 5;
+            mix.weight = 80;
+            break;
+        }
+      }
+
+      for (int i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+        LimitData & limit = g_model.limitData[i];
+        limit.min = -5 * (i % 20);
+        limit.max = 5 * (i % 20);
+        limit.offset = 10 * (i % 10);
+        limit.symetrical = i & 1;
+        limit.revert = (i >> 1) & 1;
+        limit.curve = (i % 3) ? 0 : 1 + i % MAX_CURVES;
+      }
+
+      for (int i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+        LogicalSwitchData & ls = g_model.logicalSw[i];
+        switch (i % 4) {
+          case 0:
+            ls.func = LS_FUNC_VPOS;
+            ls.v1 = MIXSRC_FIRST_INPUT + i % MAX_INPUTS;
+            ls.v2 = i % 50;
+            break;
+          case 1:
+            ls.func = LS_FUNC_AND;
+            ls.v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 1;
+            ls.v2 = SWSRC_FIRST_SWITCH;
+            break;
+          case 2:
+            ls.func = LS_FUNC_DIFFEGREATER;
+            ls.v1 = MIXSRC_FIRST_GVAR + i % MAX_GVARS;
+            ls.v2 = 5;
+            break;
+          default:
+            ls.func = LS_FUNC_STICKY;
+            ls.v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 3;
+            ls.v2 = SWSRC_FIRST_LOGICAL_SWITCH + i - 2;
+            break;
+        }
+        ls.andsw = (i % 8) ? SWSRC_NONE : SWSRC_FIRST_SWITCH;
+        ls.delay = (i % 5) ? 0 : 5;
+        ls.duration = (i % 7) ? 0 : 10;
+      }
+
+      for (int k = 0; k < MAX_FLIGHT_MODES; k++) {
+        FlightModeData & flightMode = g_model.flightModeData[k];
+        if (k > 0) {
+          flightMode.swtch = SWSRC_FIRST_SWITCH + 3 * flightModeSwitch(k) + (k & 1 ? 0 : 2);
+        }
+        flightMode.fadeIn = fadeTime;
+        flightMode.fadeOut = fadeTime;
+#if defined(GVARS)
+        for (int g = 0; g < MAX_GVARS; g++) {
+          // the other flight modes use the value of FM0
+          flightMode.gvars[g] = (k == 0 || (k + g) % 2) ? 10 * k + g : GVAR_MAX + 1;
+        }
+#endif
+      }
+    }
+
+    // the results of a test running several models are told apart by their name
+    static void report(const char * model, const char * stage, double ns)
+    {
+      if (!model) {
+        model = testing::UnitTest::GetInstance()->current_test_info()->name();
+      }
+      recordBenchmark(std::string(model) + " " + stage, ns);
+    }
+
+    void runStages(const char * model = nullptr)
+    {
+      report(model, "evalInputs", nsPerIteration([] {
+        evalInputs(e_perout_mode_normal);
+      }));
+      report(model, "evalLogicalSwitches", nsPerIteration([] {
+        evalLogicalSwitches(true);
+      }));
+      report(model, "evalFlightModeMixes", nsPerIteration([] {
+        evalFlightModeMixes(e_perout_mode_normal, 0);
+      }));
+      report(model, "applyLimits", nsPerIteration([] {
+        for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+          channelOutputs[i] = applyLimits(i, chans[i]);
+        }
+      }));
+      report(model, "evalMixes", nsPerIteration([] {
+        evalMixes(1);
+      }));
+    }
+};
+
+TEST_F(MixerBenchmark, defaultModel)
+{
+  runStages();
+}
+
+TEST_F(MixerBenchmark, worstCaseModel)
+{
+  setWorstCaseModel(0);
+  runStages();
+}
+
+// the flight mode changes every 50 ticks: several of them are always fading
+TEST_F(MixerBenchmark, worstCaseModelFading)
+{
+  setWorstCaseModel(FADING_TIME);
+  runStages();
+
+  int tick = 0;
+  report(nullptr, "evalMixesFading", nsPerIteration([&tick] {
+    if (++tick % 50 == 0) {
+      selectFlightMode((tick / 50) % MAX_FLIGHT_MODES);
+    }
+    evalMixes(1);
+  }));
+}
+
+// The mixer cycles between the 10ms ticks only evaluate the flight mode
+// faded in, the worst duration of each is reported
+TEST_F(MixerBenchmark, worstCaseModelFadingCycles)
+{
+  setWorstCaseModel(100);
+
+  // every flight mode fading
+  for (int k = 1; k < MAX_FLIGHT_MODES; k++) {
+    selectFlightMode(k);
+    evalMixes(1);
+  }
+
+  double tickMax = 0, cycleMax = 0;
+  for (int i = 0; i < 4000; i++) {
+    for (int j = 0; j < NUM_STICKS; j++) {
+      anaInValues[j] = abs((i % 800) - 400) - 200;
+    }
+    bool tick10ms = (i % 4) == 0;
+    auto start = std::chrono::steady_clock::now();
+    evalMixes(tick10ms);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (tick10ms)
+      tickMax = max(tickMax, elapsed.count());
+    else
+      cycleMax = max(cycleMax, elapsed.count());
+  }
+
+  report(nullptr, "evalMixesTickMax", tickMax);
+  report(nullptr, "evalMixesCycleMax", cycleMax);
+  EXPECT_EQ(MAX_FLIGHT_MODES - 1, getFlightMode());
+}
+
+#if defined(SDCARD_YAML)
+// the YAML models found in BENCH_MODELS_PATH/MODELS, e.g. an SD card copy
+TEST_F(MixerBenchmark, sdcardModels)
+{
+  const char * path = getenv("BENCH_MODELS_PATH");
+  if (!path) {
+    return;
+  }
+
+  simuFatfsSetPaths(path, path);
+
+  DIR dir;
+  FILINFO fno;
+  if (f_opendir(&dir, MODELS_PATH) == FR_OK) {
+    while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+      const char * ext = strrchr(fno.fname, '.');
+      if (!ext || strcmp(ext, YAML_EXT)) {
+        continue;
+      }
+
+      MODEL_RESET();
+      MIXER_RESET();
+      if (readModel(fno.fname, (uint8_t *)&g_model, sizeof(g_model))) {
+        continue;
+      }
+      loadCurves();
+
+      runStages(fno.fname);
+    }
+    f_closedir(&dir);
+  }
+
+  simuFatfsSetPaths("", "");
+}
+#endif
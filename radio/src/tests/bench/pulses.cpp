@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+#define BENCHMARK_FRAMES  10000
+
+// The bit accumulator the CRSF, SBUS and Multi encoders used before
+// pack11BitsChannels(), see tests/pulses.cpp
+static uint8_t * packChannelsReference(uint8_t * out, const uint16_t * values, int count)
+{
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (int i = 0; i < count; i++) {
+    bits |= (uint32_t)values[i] << bitsavailable;
+    bitsavailable += 11;
+    while (bitsavailable >= 8) {
+      *out++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  return out;
+}
+
+#if defined(CROSSFIRE)
+uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
+#endif
+
+#if defined(MULTIMODULE)
+void sendChannels(uint8_t moduleIdx);
+#endif
+
+TEST(PulsesBenchmark, frames)
+{
+  MODEL_RESET();
+  srand(37);
+  for (int i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    channelOutputs[i] = (rand() % 3000) - 1500;
+  }
+
+  uint16_t values[16];
+  uint8_t buffer[64];
+  for (int i = 0; i < 16; i++) {
+    values[i] = rand() & 0x7FF;
+  }
+
+  recordBenchmark("11 bits reference", nsPerIteration([&]() {
+    packChannelsReference(buffer, values, 16);
+  }, BENCHMARK_FRAMES));
+  recordBenchmark("11 bits", nsPerIteration([&]() {
+    pack11BitsChannels(&buffer[0], &values[0]);
+    pack11BitsChannels(&buffer[11], &values[8]);
+  }, BENCHMARK_FRAMES));
+  recordBenchmark("crc8", nsPerIteration([&]() {
+    buffer[0] = crc8(&buffer[1], 23);
+  }, BENCHMARK_FRAMES));
+
+#if defined(CROSSFIRE)
+  recordBenchmark("CRSF", nsPerIteration([&]() {
+    createCrossfireChannelsFrame(buffer, channelOutputs);
+  }, BENCHMARK_FRAMES));
+#endif
+
+#if defined(SBUS)
+  recordBenchmark("SBUS", nsPerIteration([]() {
+    setupPulsesSbus();
+  }, BENCHMARK_FRAMES));
+#endif
+
+#if defined(MULTIMODULE)
+  recordBenchmark("Multi", nsPerIteration([]() {
+    extmodulePulsesData.dsm2.index = 0;
+    extmodulePulsesData.dsm2.ptr = extmodulePulsesData.dsm2.pulses;
+    sendChannels(EXTERNAL_MODULE);
+  }, BENCHMARK_FRAMES));
+#endif
+
+#if defined(PXX2)
+  Pxx2Pulses pxx2;
+  recordBenchmark("PXX2", nsPerIteration([&]() {
+    pxx2.setupFrame(INTERNAL_MODULE, channelOutputs, 16);
+  }, BENCHMARK_FRAMES));
+#endif
+}
@@ -534,3 +534,146 @@ TEST(Conversions, ConversionTX16SFrom25)
 }
 #endif
 
+
+#if defined(PCBX10) && !defined(RADIO_FAMILY_T16)
+  #define CONVERSIONS_FIXTURE_PATH TESTS_BUILD_PATH "/model_23_x10/"
+#elif defined(PCBX12S)
+  #define CONVERSIONS_FIXTURE_PATH TESTS_BUILD_PATH "/model_23_x12s/"
+#elif defined(RADIO_TX16S)
+  #define CONVERSIONS_FIXTURE_PATH TESTS_BUILD_PATH "/model_25_tx16s/"
+#endif
+
+#if defined(CONVERSIONS_FIXTURE_PATH)
+#include <chrono>
+#include <string>
+#include <vector>
+#include <storage/sdcard_common.h>
+#include <storage/sdcard_raw.h>
+
+#define CONVERSIONS_CORPUS_COPIES  25
+
+static std::string readFileContent(const char * path)
+{
+  std::string content;
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) == FR_OK) {
+    UINT read = 0;
+    content.resize(f_size(&file));
+    f_read(&file, &content[0], content.size(), &read);
+    content.resize(read);
+    f_close(&file);
+  }
+  return content;
+}
+
+static void writeFileContent(const char * path, const std::string & content)
+{
+  FIL file;
+  UINT written = 0;
+  ASSERT_EQ(FR_OK, f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE));
+  f_write(&file, content.data(), content.size(), &written);
+  f_close(&file);
+  ASSERT_EQ(content.size(), written);
+}
+
+static void getCorpusFilename(char * filename, const char * prefix, int index, const char * ext)
+{
+  sprintf(filename, "%s%02d%s", prefix, index, ext);
+}
+
+TEST(Conversions, BinaryToYamlCorpus)
+{
+  simuFatfsSetPaths(CONVERSIONS_FIXTURE_PATH, CONVERSIONS_FIXTURE_PATH);
+
+  std::vector<std::string> models;
+  for (const char * path : { MODELS_PATH "/model1.bin", MODELS_PATH "/model2.bin" }) {
+    std::string content = readFileContent(path);
+    if (!content.empty())
+      models.push_back(content);
+  }
+  ASSERT_FALSE(models.empty());
+
+  char filename[32];
+  char path[64];
+  unsigned count = models.size() * CONVERSIONS_CORPUS_COPIES;
+  for (unsigned i = 0; i < count; i++) {
+    for (const char * prefix : { "ref", "new" }) {
+      getCorpusFilename(filename, prefix, i, MODELS_EXT);
+      sprintf(path, "%s/%s", MODELS_PATH, filename);
+      writeFileContent(path, models[i % models.size()]);
+    }
+  }
+
+  // the binary file rewritten at each step, then written as YAML
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < count; i++) {
+    uint8_t version = 0;
+    getCorpusFilename(filename, "ref", i, MODELS_EXT);
+    sprintf(path, "%s/%s", MODELS_PATH, filename);
+    ASSERT_EQ(nullptr, loadFileBin(path, nullptr, 0, &version));
+    if (version == 219) {
+      ASSERT_EQ(nullptr, convertModelData_219_to_220(path));
+    }
+    ASSERT_EQ(nullptr, convertModelData_220_to_221(path));
+  }
+  std::chrono::duration<double, std::milli> stepsElapsed = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < count; i++) {
+    uint8_t version = 0;
+    getCorpusFilename(filename, "new", i, MODELS_EXT);
+    ASSERT_EQ(nullptr, readModelBin(filename, nullptr, 0, &version));
+    ASSERT_EQ(nullptr, convertBinModelData(filename, version));
+  }
+  std::chrono::duration<double, std::milli> streamElapsed = std::chrono::steady_clock::now() - start;
+
+  printf("%u models converted to YAML: %.1f ms step by step, %.1f ms in one pass\n",
+         count, stepsElapsed.count(), streamElapsed.count());
+
+  for (unsigned i = 0; i < count; i++) {
+    getCorpusFilename(filename, "ref", i, YAML_EXT);
+    sprintf(path, "%s/%s", MODELS_PATH, filename);
+    std::string expected = readFileContent(path);
+
+    getCorpusFilename(filename, "new", i, YAML_EXT);
+    sprintf(path, "%s/%s", MODELS_PATH, filename);
+    std::string actual = readFileContent(path);
+
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(expected, actual) << "model " << i;
+
+    // the binary file is left as it was
+    getCorpusFilename(filename, "new", i, MODELS_EXT);
+    sprintf(path, "%s/%s", MODELS_PATH, filename);
+    EXPECT_EQ(models[i % models.size()], readFileContent(path)) << "model " << i;
+
+    // and no temporary file is left
+    getCorpusFilename(filename, "new", i, ".tmp");
+    sprintf(path, "%s/%s", MODELS_PATH, filename);
+    EXPECT_NE(FR_OK, f_stat(path, nullptr));
+  }
+
+  // a conversion run again, as after a power loss, overwrites the YAML file
+  uint8_t version = 0;
+  getCorpusFilename(filename, "new", 0, MODELS_EXT);
+  ASSERT_EQ(nullptr, readModelBin(filename, nullptr, 0, &version));
+  ASSERT_EQ(nullptr, convertBinModelData(filename, version));
+  sprintf(path, "%s/%s", MODELS_PATH, filename);
+  getCorpusFilename(filename, "ref", 0, YAML_EXT);
+  char refPath[64];
+  sprintf(refPath, "%s/%s", MODELS_PATH, filename);
+  EXPECT_EQ(readFileContent(refPath), readFileContent(path));
+
+  for (unsigned i = 0; i < count; i++) {
+    for (const char * prefix : { "ref", "new" }) {
+      for (const char * ext : { MODELS_EXT, YAML_EXT }) {
+        getCorpusFilename(filename, prefix, i, ext);
+        sprintf(path, "%s/%s", MODELS_PATH, filename);
+        f_unlink(path);
+      }
+    }
+  }
+
+  simuFatfsSetPaths("","");
+}
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+static const uint8_t checkString[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+// Bitwise MSB first CRC, independent from the tables
+static uint16_t crcReference(unsigned width, uint16_t poly, uint16_t crc, const uint8_t * buf, uint32_t len)
+{
+  uint16_t top = 1 << (width - 1);
+  uint16_t mask = (top << 1) - 1;
+  while (len--) {
+    crc ^= *buf++ << (width - 8);
+    for (int i = 0; i < 8; i++) {
+      crc = ((crc & top) ? (crc << 1) ^ poly : crc << 1) & mask;
+    }
+  }
+  return crc;
+}
+
+TEST(Crc, knownAnswers)
+{
+  EXPECT_EQ(0xBC, crc8(checkString, sizeof(checkString)));  // CRC-8/DVB-S2
+  EXPECT_EQ(0x20, crc8_BA(checkString, sizeof(checkString)));
+  EXPECT_EQ(0x31C3, crc16(CRC_1021, checkString, sizeof(checkString)));  // CRC-16/XMODEM
+  EXPECT_EQ(0x29B1, crc16(CRC_1021, checkString, sizeof(checkString), 0xFFFF));  // CRC-16/CCITT-FALSE
+  // PXX1 shifts the reflected CCITT table MSB first, not a catalogued CRC
+  EXPECT_EQ(0x604A, crc16(CRC_1189, checkString, sizeof(checkString)));
+  EXPECT_EQ(0, crc8(checkString, 0));
+}
+
+TEST(Crc, tables)
+{
+  // first entries of the tables the protocols were specified with
+  EXPECT_EQ(0xD5, (CrcTables<uint8_t, 0xD5, false, 4>::data[1]));
+  EXPECT_EQ(0xBA, (CrcTables<uint8_t, 0xBA, false, 1>::data[1]));
+  EXPECT_EQ(0x1021, (CrcTables<uint16_t, 0x1021, false, 4>::data[1]));
+  EXPECT_EQ(0x1189, (CrcTables<uint16_t, 0x8408, true, 4>::data[1]));
+  EXPECT_EQ(0x2312, (CrcTables<uint16_t, 0x8408, true, 4>::data[2]));
+  EXPECT_EQ(0x0F78, (CrcTables<uint16_t, 0x8408, true, 4>::data[255]));
+}
+
+template <class Engine>
+static void checkSlicing(unsigned width, uint16_t poly)
+{
+  uint8_t buffer[300];
+  srand(38);
+  for (int test = 0; test < 500; test++) {
+    for (unsigned i = 0; i < sizeof(buffer); i++) {
+      buffer[i] = rand();
+    }
+    uint32_t offset = test % 8;
+    uint32_t len = rand() % (sizeof(buffer) - 8);
+    uint16_t start = rand() & ((1 << width) - 1);
+    uint16_t expected = crcReference(width, poly, start, buffer + offset, len);
+    ASSERT_EQ(expected, Engine::update(start, buffer + offset, len)) << "len " << len;
+
+    // the same stream in 2 chunks
+    uint32_t split = len ? rand() % len : 0;
+    auto crc = Engine::update(start, buffer + offset, split);
+    ASSERT_EQ(expected, Engine::update(crc, buffer + offset + split, len - split)) << "split " << split;
+  }
+}
+
+TEST(Crc, slicing)
+{
+  checkSlicing<CrcEngine<uint8_t, 0xD5>>(8, 0xD5);
+  checkSlicing<CrcEngine<uint8_t, 0xD5, false, 4>>(8, 0xD5);
+  checkSlicing<CrcEngine<uint8_t, 0xD5, false, 8>>(8, 0xD5);
+  checkSlicing<CrcEngine<uint8_t, 0xBA>>(8, 0xBA);
+  checkSlicing<CrcEngine<uint8_t, 0xBA, false, 4>>(8, 0xBA);
+  checkSlicing<CrcEngine<uint16_t, 0x1021>>(16, 0x1021);
+  checkSlicing<CrcEngine<uint16_t, 0x1021, false, 2>>(16, 0x1021);
+  checkSlicing<CrcEngine<uint16_t, 0x1021, false, 4>>(16, 0x1021);
+  checkSlicing<CrcEngine<uint16_t, 0x1021, false, 8>>(16, 0x1021);
+}
+
+TEST(Crc, slicingReflectedTable)
+{
+  uint8_t buffer[300];
+  srand(38);
+  for (int test = 0; test < 500; test++) {
+    for (unsigned i = 0; i < sizeof(buffer); i++) {
+      buffer[i] = rand();
+    }
+    uint32_t len = rand() % sizeof(buffer);
+    uint16_t expected = 0;
+    for (uint32_t i = 0; i < len; i++) {
+      expected = Crc16_1189::updateByte(expected, buffer[i]);
+    }
+    ASSERT_EQ(expected, (CrcEngine<uint16_t, 0x8408, true, 2>::update(0, buffer, len)));
+    ASSERT_EQ(expected, (CrcEngine<uint16_t, 0x8408, true, 4>::update(0, buffer, len)));
+    ASSERT_EQ(expected, (CrcEngine<uint16_t, 0x8408, true, 8>::update(0, buffer, len)));
+    ASSERT_EQ(expected, crc16(CRC_1189, buffer, len));
+  }
+}
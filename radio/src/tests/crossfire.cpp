@@ -22,6 +22,8 @@
 #include "gtests.h"
 
 #if defined(CROSSFIRE)
+#include "telemetry/crossfire.h"
+
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
 TEST(Crossfire, createCrossfireChannelsFrame)
 {
@@ -44,5 +46,81 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+// Bytewise CRC8 (poly 0xD5), as crc8() was before slicing-by-4
+static uint8_t crc8Reference(const uint8_t * ptr, uint32_t len)
+{
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *ptr++;
+    for (int i = 0; i < 8; i++) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0xD5 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+TEST(Crossfire, crc8Random)
+{
+  uint8_t buffer[CROSSFIRE_FRAME_MAXLEN + 3];
+  srand(37);
+  for (int test = 0; test < 4; test++) {
+    for (unsigned i = 0; i < sizeof(buffer); i++) {
+      buffer[i] = rand();
+    }
+    // every length and alignment of the buffer
+    for (uint32_t offset = 0; offset < 4; offset++) {
+      for (uint32_t len = 0; len <= CROSSFIRE_FRAME_MAXLEN; len++) {
+        ASSERT_EQ(crc8Reference(buffer + offset, len), crc8(buffer + offset, len))
+            << "len " << len << " offset " << offset;
+      }
+    }
+  }
+}
+
+// createCrossfireChannelsFrame() as it was with the bit accumulator
+static uint8_t createCrossfireChannelsFrameReference(uint8_t * frame, int16_t * pulses)
+{
+  uint8_t * buf = frame;
+  *buf++ = MODULE_ADDRESS;
+  *buf++ = 24; // 1(ID) + 22 + 1(CRC)
+  uint8_t * crc_start = buf;
+  *buf++ = CHANNELS_ID;
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    uint32_t val = limit(0, 0x3E0 + (pulses[i] * 4) / 5, 2 * 0x3E0);
+    bits |= val << bitsavailable;
+    bitsavailable += 11;
+    while (bitsavailable >= 8) {
+      *buf++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  *buf++ = crc8Reference(crc_start, 23);
+  return buf - frame;
+}
+
+TEST(Crossfire, createCrossfireChannelsFrameRandom)
+{
+  int16_t pulses[CROSSFIRE_CHANNELS_COUNT];
+  uint8_t expected[CROSSFIRE_FRAME_MAXLEN];
+  uint8_t frame[CROSSFIRE_FRAME_MAXLEN];
+
+  MODEL_RESET();
+  srand(37);
+  for (int test = 0; test < 1000; test++) {
+    for (int i = 0; i < CROSSFIRE_CHANNELS_COUNT; i++) {
+      // includes values out of the [-1024:+1024] range
+      pulses[i] = (rand() % 3000) - 1500;
+    }
+    memset(expected, 0, sizeof(expected));
+    memset(frame, 0, sizeof(frame));
+    uint8_t len = createCrossfireChannelsFrameReference(expected, pulses);
+    ASSERT_EQ(len, createCrossfireChannelsFrame(frame, pulses));
+    ASSERT_EQ(0, memcmp(expected, frame, sizeof(frame))) << "test " << test;
+  }
+}
 #endif
 
@@ -25,24 +25,139 @@ extern const char * eepromFile;
 
 #if defined(RTC_BACKUP_RAM)
 #include "storage/rtc_backup.h"
-namespace Backup {
-#define BACKUP
-#include "datastructs_private.h"
-PACK(struct RamBackupUncompressed {
-  ModelData model;
-  RadioData radio;
-});
-#undef BACKUP
+
+class RamBackupTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    MODEL_RESET();
+    RADIO_RESET();
+    memset(ramBackup, 0, sizeof(RamBackup));
+    strcpy(g_model.header.name, "Backup");
+    g_model.mixData[0].weight = 100;
+  }
+
+  void TearDown() override
+  {
+    MODEL_RESET();
+    RADIO_RESET();
+  }
+
+  uint32_t logSize() const
+  {
+    return (ramBackup->log >> 16) - (ramBackup->log & 0xFFFF);
+  }
 };
-extern Backup::RamBackupUncompressed ramBackupUncompressed;
-TEST(Storage, BackupAndRestore)
+
+TEST_F(RamBackupTest, BackupAndRestore)
+{
+  ModelData model = g_model;
+  RadioData radio = g_eeGeneral;
+  rambackupWrite();
+
+  MODEL_RESET();
+  RADIO_RESET();
+  EXPECT_TRUE(rambackupRestore());
+  EXPECT_EQ(0, memcmp(&model, &g_model, sizeof(ModelData)));
+  EXPECT_EQ(0, memcmp(&radio, &g_eeGeneral, sizeof(RadioData)));
+}
+
+TEST_F(RamBackupTest, IncrementalWrite)
+{
+  rambackupWrite();
+  uint32_t snapshotSize = logSize();
+
+  // nothing changed, nothing written
+  rambackupWrite();
+  EXPECT_EQ(snapshotSize, logSize());
+
+  // only the section holding the name is appended
+  strcpy(g_model.header.name, "Changed");
+  rambackupWrite();
+  EXPECT_GT(logSize(), snapshotSize);
+  EXPECT_LT(logSize() - snapshotSize, RAM_BACKUP_SECTION_SIZE / 2);
+
+  ModelData model = g_model;
+  MODEL_RESET();
+  EXPECT_TRUE(rambackupRestore());
+  EXPECT_EQ(0, memcmp(&model, &g_model, sizeof(ModelData)));
+}
+
+TEST_F(RamBackupTest, LogWrapAround)
 {
+  // fill the log until new snapshots get written
+  for (int i = 0; i < 500; i++) {
+    g_model.mixData[i % MAX_MIXERS].weight = i % 100;
+    g_model.header.name[i % LEN_MODEL_NAME] = 'a' + i % 26;
+    rambackupWrite();
+  }
+
+  ModelData model = g_model;
+  MODEL_RESET();
+  EXPECT_TRUE(rambackupRestore());
+  EXPECT_EQ(0, memcmp(&model, &g_model, sizeof(ModelData)));
+}
+
+TEST_F(RamBackupTest, TornWrite)
+{
+  int checked = 0;
+
+  for (int i = 0; i < 100; i++) {
+    g_model.mixData[i % MAX_MIXERS].weight = i % 100;
+    strcpy(g_model.header.name, i & 1 ? "Odd" : "Even");
+    ModelData model = g_model;
+    rambackupWrite();
+    RamBackup before = *ramBackup;
+
+    g_model.mixData[(i + 1) % MAX_MIXERS].weight = -100;
+    strcpy(g_model.header.name, "Next");
+    rambackupWrite();
+    RamBackup after = *ramBackup;
+
+    uint32_t begin = before.log & 0xFFFF;
+    uint32_t end = before.log >> 16;
+    if (memcmp(&before.data[begin], &after.data[begin], end - begin) != 0) {
+      // whole log rewritten in place, not safe against resets
+      continue;
+    }
+
+    // reset after only some of the bytes of the last write reached the
+    // backup RAM, in the order they are written: records from the end of
+    // the log onwards, log offsets last
+    for (unsigned torn = 0; torn < sizeof(ramBackup->data); torn += 7) {
+      *ramBackup = before;
+      for (unsigned j = 0; j < torn; j++) {
+        unsigned offset = (end + j) % sizeof(ramBackup->data);
+        ramBackup->data[offset] = after.data[offset];
+      }
+
+      MODEL_RESET();
+      ASSERT_TRUE(rambackupRestore()) << "iteration " << i << ", torn at " << torn;
+      ASSERT_EQ(0, memcmp(&model, &g_model, sizeof(ModelData))) << "iteration " << i << ", torn at " << torn;
+    }
+
+    *ramBackup = after;
+    g_model = model;
+    checked++;
+  }
+
+  EXPECT_GT(checked, 90);
+}
+
+TEST_F(RamBackupTest, InvalidBackup)
+{
+  EXPECT_FALSE(rambackupRestore());
+
+  for (unsigned i = 0; i < sizeof(ramBackup->data); i++) {
+    ramBackup->data[i] = rand();
+  }
+  ramBackup->log = 0 | (sizeof(ramBackup->data) << 16);
+  EXPECT_FALSE(rambackupRestore());
+
   rambackupWrite();
-  Backup::RamBackupUncompressed ramBackupRestored;
-  if (uncompress((uint8_t *)&ramBackupRestored, sizeof(ramBackupRestored), ramBackup->data, ramBackup->size) != sizeof(ramBackupUncompressed))
-    TRACE("ERROR uncompress");
-  if (memcmp(&ramBackupUncompressed, &ramBackupRestored, sizeof(ramBackupUncompressed)) != 0)
-    TRACE("ERROR restore");
+  ramBackup->data[(ramBackup->log & 0xFFFF) + sizeof(RamBackupRecord) + 1] ^= 0x55;
+  EXPECT_FALSE(rambackupRestore());
 }
 #endif
 
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <deque>
+#include <vector>
+#include "gtests.h"
+#include "location.h"
+#include "io/frsky_firmware_update.h"
+
+#define FIRMWARE_FILENAME  "/firmware.frk"
+#define DEVICE_BASE        0x08004000
+
+#define DEVICE_VERSION     0x00010203
+
+// A device in its bootloader, on a full duplex link, answering the frames
+// sent to it. It writes the
+// word it expects next, asks for it again when it receives an older one, and
+// ignores the ones ahead. Data words and requests may be lost, and the
+// requests may be received out of order.
+class SimulatedDevice: public FrskyDeviceFirmwareUpdate
+{
+  public:
+    std::vector<uint8_t> flash;
+    uint32_t expected = 0;
+    unsigned dropRate = 0;     // % of frames lost
+    unsigned reorderRate = 0;  // % of requests overtaken by the next one
+    bool resendOnTimeout = false;
+    unsigned sentWords = 0;
+
+    explicit SimulatedDevice(ModuleIndex module):
+      FrskyDeviceFirmwareUpdate(module)
+    {
+      fullDuplex = true;
+    }
+
+    uint8_t getWindow() const
+    {
+      return window;
+    }
+
+    const char * upload(FIL * file)
+    {
+      return uploadFileNormal(FIRMWARE_FILENAME, file, [](const char *, const char *, int, int) {});
+    }
+
+  protected:
+    std::deque<std::vector<uint8_t>> replies;
+    uint8_t reply[8];
+
+    bool lost()
+    {
+      return dropRate && unsigned(rand() % 100) < dropRate;
+    }
+
+    void sendReply(uint8_t prim, uint32_t value = 0)
+    {
+      std::vector<uint8_t> frame = {0x5E, 0x50, prim};
+      for (int i = 0; i < 4; i++) {
+        frame.push_back(value >> (8 * i));
+      }
+      if (prim == 0x82 && lost())
+        return;
+      if (reorderRate && !replies.empty() && unsigned(rand() % 100) < reorderRate)
+        replies.insert(replies.end() - 1, frame);
+      else
+        replies.push_back(frame);
+    }
+
+    void sendFrame() override
+    {
+      uint8_t prim = frame[1];
+
+      switch (prim) {
+        case 0: // REQ_POWERUP
+          sendReply(0x80);
+          break;
+
+        case 1: // REQ_VERSION
+          sendReply(0x81, DEVICE_VERSION);
+          break;
+
+        case 3: // CMD_DOWNLOAD
+          expected = 0;
+          sendReply(0x82, DEVICE_BASE);
+          break;
+
+        case 4: // DATA_WORD
+        {
+          sentWords++;
+          if (lost())
+            break;
+          uint8_t behind = uint8_t((DEVICE_BASE + expected) - frame[6]);
+          if (behind == 0) {
+            flash.insert(flash.end(), &frame[2], &frame[6]);
+            expected += 4;
+            sendReply(0x82, DEVICE_BASE + expected);
+          }
+          else if (behind < 128) {
+            sendReply(0x82, DEVICE_BASE + expected);
+          }
+          break;
+        }
+
+        case 5: // DATA_EOF
+          sendReply(0x83);
+          break;
+      }
+    }
+
+    const uint8_t * readFrame(uint32_t timeout) override
+    {
+      // a stop-and-wait device asks again after its own timeout, a few times
+      // before the sender gives up
+      for (int i = 0; resendOnTimeout && replies.empty() && i < 3; i++) {
+        sendReply(0x82, DEVICE_BASE + expected);
+      }
+      if (replies.empty()) {
+        return nullptr;
+      }
+      memcpy(reply, replies.front().data(), replies.front().size());
+      replies.pop_front();
+      return reply;
+    }
+};
+
+class FirmwareUpdateTest: public testing::Test
+{
+  protected:
+    std::vector<uint8_t> firmware;
+    FIL file;
+
+    void SetUp() override
+    {
+      simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+    }
+
+    void TearDown() override
+    {
+      simuFatfsSetPaths("", "");
+    }
+
+    void writeFirmware(uint32_t size)
+    {
+      firmware.resize(size);
+      for (uint32_t i = 0; i < size; i++) {
+        firmware[i] = rand();
+      }
+
+      FrSkyFirmwareInformation information;
+      memset(&information, 0, sizeof(information));
+      information.fourcc = 0x4B535246;
+      information.headerVersion = 1;
+      information.size = size;
+
+      FILE * f = fopen(TESTS_BUILD_PATH FIRMWARE_FILENAME, "wb");
+      ASSERT_NE(nullptr, f);
+      fwrite(&information, 1, sizeof(information), f);
+      fwrite(firmware.data(), 1, size, f);
+      fclose(f);
+    }
+
+    // opens the file as doFlashFirmware() does, the header is already read
+    void openFirmware()
+    {
+      FrSkyFirmwareInformation information;
+      UINT count;
+      ASSERT_EQ(FR_OK, f_open(&file, FIRMWARE_FILENAME, FA_READ));
+      ASSERT_EQ(FR_OK, f_read(&file, &information, sizeof(information), &count));
+    }
+
+    void upload(SimulatedDevice & device, const char * expectedResult = nullptr)
+    {
+      openFirmware();
+      EXPECT_EQ(expectedResult, device.upload(&file));
+      f_close(&file);
+      if (!expectedResult) {
+        // the trailing bytes are not part of the last word, they are not sent
+        ASSERT_EQ(firmware.size() & ~3u, device.flash.size());
+        EXPECT_EQ(0, memcmp(firmware.data(), device.flash.data(), device.flash.size()));
+      }
+    }
+};
+
+// No bootloader is known to accept a window yet: stop-and-wait by default
+TEST_F(FirmwareUpdateTest, stopAndWait)
+{
+  srand(37);
+  writeFirmware(5000 + 3);
+  SimulatedDevice device(INTERNAL_MODULE);
+  upload(device);
+  EXPECT_EQ(1, device.getWindow());
+  EXPECT_EQ(device.flash.size() / 4, device.sentWords);
+}
+
+TEST_F(FirmwareUpdateTest, stopAndWaitWithLosses)
+{
+  srand(37);
+  writeFirmware(5000);
+  SimulatedDevice device(INTERNAL_MODULE);
+  device.dropRate = 5;
+  device.resendOnTimeout = true;
+  upload(device);
+}
+
+TEST_F(FirmwareUpdateTest, stopAndWaitDeviceTimeout)
+{
+  srand(37);
+  writeFirmware(1024);
+  SimulatedDevice device(INTERNAL_MODULE);
+  device.dropRate = 5;
+  upload(device, STR_DEVICE_DATA_REFUSED);
+}
+
+TEST_F(FirmwareUpdateTest, pipelined)
+{
+  for (uint8_t window = 2; window <= FIRMWARE_MAX_WINDOW; window *= 2) {
+    srand(37);
+    writeFirmware(10000 + window);
+    SimulatedDevice device(INTERNAL_MODULE);
+    device.setWindow(window);
+    upload(device);
+    EXPECT_EQ(window, device.getWindow());
+    EXPECT_EQ(device.flash.size() / 4, device.sentWords) << "window " << int(window);
+  }
+}
+
+TEST_F(FirmwareUpdateTest, pipelinedWithLossesAndReordering)
+{
+  for (uint8_t window = 2; window <= FIRMWARE_MAX_WINDOW; window *= 2) {
+    for (int resend = 0; resend < 2; resend++) {
+      srand(37);
+      writeFirmware(10000 + window);
+      SimulatedDevice device(INTERNAL_MODULE);
+      device.setWindow(window);
+      device.dropRate = 3;
+      device.reorderRate = 20;
+      device.resendOnTimeout = resend;
+      upload(device);
+      printf("window %2d: %u words sent for %u\n", window, device.sentWords, unsigned(device.flash.size() / 4));
+    }
+  }
+}
@@ -113,7 +113,81 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
   evalFunctions(g_model.customFn, modelFunctionsContext);
   EXPECT_EQ(g_model.flightModeData[0].gvars[0], 28);
 }
+
+TEST_F(SpecialFunctionsTest, GvarsIncSharedSwitch)
+{
+  simuSetSwitch(0, 0);    // SA-
+
+  for (int i = 0; i < 2; i++) {
+    g_model.customFn[i].swtch = SWSRC_SA0;
+    g_model.customFn[i].func = FUNC_ADJUST_GVAR;
+    g_model.customFn[i].all.mode = FUNC_ADJUST_GVAR_INCDEC;
+    g_model.customFn[i].all.param = 0; // GV1
+    g_model.customFn[i].all.val = i + 1;
+    g_model.customFn[i].active = true;
+  }
+  // the same switch inverted
+  g_model.customFn[2] = g_model.customFn[0];
+  g_model.customFn[2].swtch = -SWSRC_SA0;
+  g_model.customFn[2].all.val = -10;
+
+  g_model.flightModeData[0].gvars[0] = 10;  // GV1 = 10;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 0);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 0);
+
+  simuSetSwitch(0, -1);  // SAdown
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 3);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 3);
+
+  simuSetSwitch(0, 0);    // SA-
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], -7);
+}
 #endif // #if defined(GVARS)
 
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+TEST_F(SpecialFunctionsTest, OverrideChannelSharedSwitch)
+{
+  simuSetSwitch(0, 0);    // SA-
+
+  for (int i = 0; i < 4; i++) {
+    g_model.customFn[i].swtch = i < 3 ? SWSRC_SA0 : -SWSRC_SA0;
+    g_model.customFn[i].func = FUNC_OVERRIDE_CHANNEL;
+    g_model.customFn[i].all.param = i < 2 ? 0 : i;  // CH1 twice, the last one wins
+    g_model.customFn[i].all.val = 10 * (i + 1);
+    g_model.customFn[i].active = true;
+  }
+
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[2], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[3], 40);
+
+  simuSetSwitch(0, -1);  // SAdown
+  for (int tick = 0; tick < 2; tick++) {
+    evalFunctions(g_model.customFn, modelFunctionsContext);
+    EXPECT_EQ(safetyCh[0], 20);
+    EXPECT_EQ(safetyCh[1], OVERRIDE_CHANNEL_UNDEFINED);
+    EXPECT_EQ(safetyCh[2], 30);
+    EXPECT_EQ(safetyCh[3], OVERRIDE_CHANNEL_UNDEFINED);
+  }
+
+  // disabled function
+  g_model.customFn[1].active = false;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], 10);
+
+  g_model.customFn[0].swtch = SWSRC_NONE;
+  g_model.customFn[2].swtch = SWSRC_NONE;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[2], OVERRIDE_CHANNEL_UNDEFINED);
+}
+#endif // #if defined(OVERRIDE_CHANNEL_FUNCTION)
+
 #endif // #if defined(PCBFRSKY)
 
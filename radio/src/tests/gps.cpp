@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(INTERNAL_GPS)
+
+#include "gps_ubx.h"
+
+static void putU2(uint8_t * p, uint16_t value)
+{
+  p[0] = value;
+  p[1] = value >> 8;
+}
+
+static void putU4(uint8_t * p, uint32_t value)
+{
+  putU2(p, value);
+  putU2(p + 2, value >> 16);
+}
+
+static size_t createNavPvtFrame(uint8_t * frame)
+{
+  uint8_t payload[UBX_NAV_PVT_LEN];
+  memset(payload, 0, sizeof(payload));
+  putU2(&payload[4], 2022);
+  payload[6] = 6;             // month
+  payload[7] = 21;            // day
+  payload[8] = 13;            // hour
+  payload[9] = 37;            // min
+  payload[10] = 42;           // sec
+  payload[11] = 0x03;         // date + time valid
+  payload[20] = 3;            // 3D fix
+  payload[21] = 0x01;         // gnssFixOK
+  payload[23] = 12;           // numSV
+  putU4(&payload[24], -1234567890);  // lon
+  putU4(&payload[28], 487654321);    // lat
+  putU4(&payload[36], 123456);       // hMSL
+  putU4(&payload[60], 15000);        // gSpeed
+  putU4(&payload[64], 27012345);     // headMot
+  putU2(&payload[76], 123);          // pDOP
+  return ubxBuildFrame(frame, UBX_CLASS_NAV, UBX_NAV_PVT, payload, sizeof(payload));
+}
+
+static void checkNavPvt(const ubx_nav_pvt_t & pvt)
+{
+  EXPECT_EQ(2022, pvt.year);
+  EXPECT_EQ(6, pvt.month);
+  EXPECT_EQ(21, pvt.day);
+  EXPECT_EQ(13, pvt.hour);
+  EXPECT_EQ(37, pvt.min);
+  EXPECT_EQ(42, pvt.sec);
+  EXPECT_EQ(3, pvt.fixType);
+  EXPECT_EQ(12, pvt.numSV);
+  EXPECT_EQ(-1234567890, pvt.lon);
+  EXPECT_EQ(487654321, pvt.lat);
+  EXPECT_EQ(123456, pvt.hMSL);
+  EXPECT_EQ(15000, pvt.gSpeed);
+  EXPECT_EQ(27012345, pvt.headMot);
+  EXPECT_EQ(123, pvt.pDOP);
+}
+
+TEST(Gps, ubxNavPvt)
+{
+  uint8_t frame[UBX_NAV_PVT_LEN + UBX_FRAME_OVERHEAD];
+  size_t size = createNavPvtFrame(frame);
+  ASSERT_EQ(sizeof(frame), size);
+
+  ubx_parser_t parser;
+  ubxParserInit(&parser);
+
+  UbxResult result;
+  EXPECT_EQ(size, ubxParse(&parser, frame, size, &result));
+  ASSERT_EQ(UBX_MESSAGE, result);
+
+  ubx_nav_pvt_t pvt;
+  ASSERT_TRUE(ubxDecodeNavPvt(&parser, &pvt));
+  checkNavPvt(pvt);
+}
+
+TEST(Gps, ubxSplitFrame)
+{
+  uint8_t frame[UBX_NAV_PVT_LEN + UBX_FRAME_OVERHEAD];
+  size_t size = createNavPvtFrame(frame);
+
+  for (size_t split = 1; split < size; split++) {
+    ubx_parser_t parser;
+    ubxParserInit(&parser);
+
+    UbxResult result;
+    EXPECT_EQ(split, ubxParse(&parser, frame, split, &result));
+    EXPECT_EQ(UBX_NONE, result);
+    EXPECT_TRUE(ubxParserBusy(&parser));
+    EXPECT_EQ(size - split, ubxParse(&parser, frame + split, size - split, &result));
+    EXPECT_EQ(UBX_MESSAGE, result);
+  }
+}
+
+TEST(Gps, ubxChecksumError)
+{
+  uint8_t frame[UBX_NAV_PVT_LEN + UBX_FRAME_OVERHEAD];
+  size_t size = createNavPvtFrame(frame);
+  frame[30] ^= 0x01;
+
+  ubx_parser_t parser;
+  ubxParserInit(&parser);
+
+  UbxResult result;
+  ubxParse(&parser, frame, size, &result);
+  EXPECT_EQ(UBX_CHECKSUM_ERROR, result);
+  EXPECT_FALSE(ubxParserBusy(&parser));
+}
+
+TEST(Gps, ubxRandomData)
+{
+  uint8_t frame[UBX_NAV_PVT_LEN + UBX_FRAME_OVERHEAD];
+  size_t size = createNavPvtFrame(frame);
+
+  uint8_t capture[16384];
+  size_t len = 0;
+  int frames = 0;
+  uint32_t seed = 0x12345678;
+  while (len + size + 64 < sizeof(capture)) {
+    // random garbage between frames (without sync byte)
+    seed = seed * 1103515245 + 12345;
+    for (int n = (seed >> 16) & 0x3F; n > 0; n--) {
+      seed = seed * 1103515245 + 12345;
+      uint8_t c = seed >> 16;
+      capture[len++] = (c == UBX_SYNC1 ? 0 : c);
+    }
+    memcpy(&capture[len], frame, size);
+    len += size;
+    frames++;
+  }
+
+  ubx_parser_t parser;
+  ubxParserInit(&parser);
+
+  int decoded = 0;
+  const uint8_t * data = capture;
+  while (len > 0) {
+    UbxResult result;
+    size_t consumed = ubxParse(&parser, data, len, &result);
+    ASSERT_LE(consumed, len);
+    // a lost sync hands back the current byte without consuming it
+    data += consumed ? consumed : 1;
+    len -= consumed ? consumed : 1;
+    ubx_nav_pvt_t pvt;
+    if (result == UBX_MESSAGE && ubxDecodeNavPvt(&parser, &pvt)) {
+      checkNavPvt(pvt);
+      decoded++;
+    }
+  }
+  EXPECT_EQ(frames, decoded);
+}
+
+TEST(Gps, nmeaAndUbxInput)
+{
+  memset(&gpsData, 0, sizeof(gpsData));
+
+  const char * gga = "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,";
+  uint8_t parity = 0;
+  for (const char * c = gga; *c; c++) {
+    parity ^= *c;
+  }
+  char sentence[128];
+  snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", gga, parity);
+  gpsNewData((const uint8_t *)sentence, strlen(sentence));
+
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(1, gpsData.fix);
+  EXPECT_EQ(8, gpsData.numSat);
+  EXPECT_EQ(48117300, gpsData.latitude);
+  EXPECT_EQ(11516666, gpsData.longitude);
+  EXPECT_EQ(545, gpsData.altitude);
+
+  uint8_t frame[UBX_NAV_PVT_LEN + UBX_FRAME_OVERHEAD];
+  size_t size = createNavPvtFrame(frame);
+  gpsNewData(frame, size);
+
+  EXPECT_EQ(2u, gpsData.packetCount);
+  EXPECT_EQ(1, gpsData.fix);
+  EXPECT_EQ(12, gpsData.numSat);
+  EXPECT_EQ(48765432, gpsData.latitude);
+  EXPECT_EQ(-123456789, gpsData.longitude);
+  EXPECT_EQ(123, gpsData.altitude);
+  EXPECT_EQ(1500, gpsData.speed);
+  EXPECT_EQ(2701, gpsData.groundCourse);
+}
+
+#endif
@@ -513,4 +513,98 @@ TEST(Lcd, lcdDrawLine)
   EXPECT_TRUE(checkScreenshot("lcdDrawLine"));
 }
 #endif
+
+#if LCD_W == 128
+// Copies the spans returned by lcdGetRefreshSpans() from the shadow buffer
+// into the LCD memory, as the LCD driver does
+static uint32_t sendRefreshSpans(pixel_t * lcd, const pixel_t * shadow, const LcdSpan * spans, uint8_t count)
+{
+  uint32_t bytes = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    unsigned offset = spans[i].page * LCD_W + spans[i].start;
+    memcpy(lcd + offset, shadow + offset, spans[i].length);
+    bytes += spans[i].length;
+  }
+  return bytes;
+}
+
+TEST(Lcd, refreshSpans)
+{
+  pixel_t shadow[DISPLAY_BUFFER_SIZE];
+  pixel_t lcd[DISPLAY_BUFFER_SIZE];
+  LcdSpan spans[(LCD_H + 7) / 8];
+
+  // whatever the LCD and shadow contents, a full refresh sends everything
+  memset(shadow, 0xA5, sizeof(shadow));
+  memset(lcd, 0x5A, sizeof(lcd));
+  lcdClear();
+  uint8_t count = lcdGetRefreshSpans(shadow, spans, true);
+  EXPECT_EQ((LCD_H + 7) / 8, count);
+  EXPECT_EQ((uint32_t)DISPLAY_BUFFER_SIZE, sendRefreshSpans(lcd, shadow, spans, count));
+  EXPECT_EQ(0, memcmp(lcd, displayBuf, sizeof(lcd)));
+
+  EXPECT_EQ(0, lcdGetRefreshSpans(shadow, spans, false));
+
+  srand(37);
+  for (int test = 0; test < 1000; test++) {
+    int changes = rand() % 8;
+    for (int i = 0; i < changes; i++) {
+      displayBuf[rand() % DISPLAY_BUFFER_SIZE] ^= 1 << (rand() % 8);
+    }
+    if (test % 10 == 0) {
+      lcdDrawNumber(rand() % (LCD_W - 30), rand() % (LCD_H - FH), rand() % 10000, INVERS);
+    }
+    count = lcdGetRefreshSpans(shadow, spans, false);
+    sendRefreshSpans(lcd, shadow, spans, count);
+    ASSERT_EQ(0, memcmp(lcd, displayBuf, sizeof(lcd))) << "test " << test;
+    ASSERT_EQ(0, memcmp(shadow, displayBuf, sizeof(shadow))) << "test " << test;
+  }
+
+  // one changed byte per page
+  for (int page = 0; page < (LCD_H + 7) / 8; page++) {
+    displayBuf[page * LCD_W + page] ^= 0x01;
+  }
+  count = lcdGetRefreshSpans(shadow, spans, false);
+  EXPECT_EQ((LCD_H + 7) / 8, count);
+  EXPECT_EQ((uint32_t)count, sendRefreshSpans(lcd, shadow, spans, count));
+  EXPECT_EQ(0, memcmp(lcd, displayBuf, sizeof(lcd)));
+}
+
+TEST(Lcd, refreshSpansMainViews)
+{
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.timers[0].mode = TMRMODE_ON;
+  g_model.timers[1].mode = TMRMODE_ON;
+
+  pixel_t shadow[DISPLAY_BUFFER_SIZE];
+  pixel_t lcd[DISPLAY_BUFFER_SIZE];
+  LcdSpan spans[(LCD_H + 7) / 8];
+  const int frames = 100;
+
+  for (uint8_t view = VIEW_OUTPUTS_VALUES; view <= VIEW_TIMER2; view++) {
+    g_eeGeneral.view = view;
+    lcdClear();
+    menuMainView(0);
+    sendRefreshSpans(lcd, shadow, spans, lcdGetRefreshSpans(shadow, spans, true));
+
+    uint32_t bytes = 0;
+    for (int frame = 0; frame < frames; frame++) {
+      timersStates[0].val = frame;
+      timersStates[1].val = 2 * frame;
+      channelOutputs[frame % 8] = (frame * 37) % 2048 - 1024;
+      lcdClear();
+      menuMainView(0);
+      uint8_t count = lcdGetRefreshSpans(shadow, spans, false);
+      bytes += sendRefreshSpans(lcd, shadow, spans, count);
+      ASSERT_EQ(0, memcmp(lcd, displayBuf, sizeof(lcd))) << "view " << (int)view << " frame " << frame;
+    }
+
+    printf("main view %d: %u bytes per frame instead of %u\n", view,
+           bytes / frames, (unsigned)DISPLAY_BUFFER_SIZE);
+    EXPECT_LT(bytes / frames, (uint32_t)DISPLAY_BUFFER_SIZE);
+  }
+}
+#endif
 #endif
@@ -829,6 +829,120 @@ TEST_F(MixerTest, flightModeOverflow)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, 1024);
 }
 
+// Each flight mode k > 0 is selected by one position of SA..SD, and drives
+// CH1 from the rudder stick with its own weight
+static void setFadingFlightModes(uint8_t fadeTime)
+{
+  for (int k = 0; k < MAX_FLIGHT_MODES; k++) {
+    if (k > 0) {
+      int sw = (k - 1) / 2;
+      g_model.flightModeData[k].swtch = SWSRC_FIRST_SWITCH + 3 * sw + (k & 1 ? 0 : 2);
+    }
+    g_model.flightModeData[k].fadeIn = fadeTime;
+    g_model.flightModeData[k].fadeOut = fadeTime;
+    g_model.mixData[k].destCh = 0;
+    g_model.mixData[k].mltpx = MLTPX_REPL;
+    g_model.mixData[k].srcRaw = MIXSRC_Rud;
+    g_model.mixData[k].flightModes = ((1 << MAX_FLIGHT_MODES) - 1) & ~(1 << k);
+    g_model.mixData[k].weight = 100 - 20 * k;
+  }
+}
+
+static void selectFlightMode(int k)
+{
+  for (int sw = 0; sw < 4; sw++) {
+    simuSetSwitch(sw, 0);
+  }
+  if (k > 0) {
+    simuSetSwitch((k - 1) / 2, k & 1 ? -1 : 1);
+  }
+}
+
+static void setSticks(int value)
+{
+  for (int i = 0; i < NUM_STICKS; i++) {
+    anaInValues[i] = value;
+  }
+}
+
+TEST_F(MixerTest, flightModesFadeWithMovingSticks)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+
+  // no fade: leaves every flight mode out of the fade, FM0 active
+  setFadingFlightModes(0);
+  for (int k = 1; k <= MAX_FLIGHT_MODES; k++) {
+    selectFlightMode(k % MAX_FLIGHT_MODES);
+    evalMixes(1);
+  }
+
+  // 1s fades, all the flight modes one after the other
+  setFadingFlightModes(10);
+  const int32_t delta = (0xffff / 10) / 10;
+  const int cyclesPerTick = 4;
+  const int stickStep = 3;
+  int32_t fade[MAX_FLIGHT_MODES] = { 0xffff };
+  uint16_t fading = 0;
+  int current = 0;
+  int stick = -400;
+  int direction = stickStep;
+
+  for (int tick = 0; tick < 300; tick++) {
+    if (tick % 10 == 1 && current < MAX_FLIGHT_MODES - 1) {
+      fading |= (1 << current) + (1 << (current + 1));
+      selectFlightMode(++current);
+    }
+
+    for (int cycle = 0; cycle < cyclesPerTick; cycle++) {
+      bool tick10ms = (cycle == cyclesPerTick - 1);
+      if (stick + direction > 400 || stick + direction < -400)
+        direction = -direction;
+      stick += direction;
+      setSticks(stick);
+      evalMixes(tick10ms);
+
+      int32_t value = getValue(MIXSRC_Rud);
+      double expected;
+      if (fading) {
+        double sum = 0, weight = 0;
+        for (int k = 0; k < MAX_FLIGHT_MODES; k++) {
+          if (fading & (1 << k)) {
+            sum += (double)value * (100 - 20 * k) / 100 * fade[k];
+            weight += fade[k];
+          }
+        }
+        expected = sum / weight;
+      }
+      else {
+        expected = (double)value * (100 - 20 * current) / 100;
+      }
+
+      // the inactive flight modes lag at most one tick behind the sticks
+      double tolerance = 2 + (double)stickStep * (cyclesPerTick - 1) * 2;
+      GTEST_ASSERT_LE(fabs(expected - channelOutputs[0]), tolerance) << "tick " << tick << " cycle " << cycle;
+
+      if (tick10ms) {
+        for (int k = 0; k < MAX_FLIGHT_MODES; k++) {
+          if (fading & (1 << k)) {
+            if (k == current)
+              fade[k] = min<int32_t>(0xffff, fade[k] + delta);
+            else
+              fade[k] = max<int32_t>(0, fade[k] - delta);
+            if (fade[k] == 0 || fade[k] == 0xffff)
+              fading &= ~(1 << k);
+          }
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ(0, fading);
+  EXPECT_EQ(MAX_FLIGHT_MODES - 1, getFlightMode());
+}
+
 TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 {
   g_model.thrTrim = 1;
@@ -977,3 +1091,78 @@ TEST_F(TrimsTest, invertedThrottlePlusThrottleTrimWithCrossTrims)
   EXPECT_EQ(channelOutputs[2], +1024);
   EXPECT_EQ(channelOutputs[1], 0);
 }
+
+#if defined(GVARS)
+// The flight mode GVar lookups as they were done before the resolved values
+static int16_t getGVarValueReference(int8_t gv, int8_t fm)
+{
+  int8_t mul = 1;
+  if (gv < 0) {
+    gv = -1-gv;
+    mul = -1;
+  }
+  return GVAR_VALUE(gv, getGVarFlightMode(fm, gv)) * mul;
+}
+
+static void randomGVars()
+{
+  for (int fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (int gv = 0; gv < MAX_GVARS; gv++) {
+      if (fm > 0 && rand() % 2) {
+        // link to another flight mode, cycles included
+        g_model.flightModeData[fm].gvars[gv] = GVAR_MAX + 1 + rand() % (MAX_FLIGHT_MODES - 1);
+      }
+      else {
+        g_model.flightModeData[fm].gvars[gv] = rand() % (2 * GVAR_MAX + 1) - GVAR_MAX;
+      }
+    }
+  }
+}
+
+static void expectGVarsResolved()
+{
+  for (int fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (int gv = -MAX_GVARS; gv < MAX_GVARS; gv++) {
+      ASSERT_EQ(getGVarValueReference(gv, fm), getGVarValue(gv, fm)) << "FM" << fm << " GV" << gv;
+    }
+  }
+}
+
+TEST_F(MixerTest, GVarsResolvedValues)
+{
+  srand(37);
+  for (int test = 0; test < 200; test++) {
+    randomGVars();
+    checkGVars();
+    expectGVarsResolved();
+
+    // a single value or link modified
+    int fm = rand() % MAX_FLIGHT_MODES;
+    int gv = rand() % MAX_GVARS;
+    g_model.flightModeData[fm].gvars[gv] = fm > 0 && rand() % 2 ? GVAR_MAX + 1 : rand() % 100;
+    checkGVars();
+    expectGVarsResolved();
+
+    // through the special functions and trims path
+    int16_t value = rand() % 100;
+    setGVarValue(gv, value, fm);
+    EXPECT_EQ(value, getGVarValue(gv, fm));
+    expectGVarsResolved();
+  }
+}
+
+TEST_F(MixerTest, GVarWeightModified)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = GV_CALC_VALUE_IDX_POS(0, GV1_LARGE);  // GV1
+  g_model.flightModeData[0].gvars[0] = 50;
+  evalMixes(1);
+  EXPECT_EQ(chans[0], CHANNEL_MAX/2);
+
+  // modified directly, as the menus do
+  g_model.flightModeData[0].gvars[0] = -25;
+  evalMixes(1);
+  EXPECT_EQ(chans[0], -CHANNEL_MAX/4);
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+// The bit accumulator the CRSF, SBUS and Multi encoders used before
+// pack11BitsChannels()
+static uint8_t * packChannelsReference(uint8_t * out, const uint16_t * values, int count)
+{
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (int i = 0; i < count; i++) {
+    bits |= (uint32_t)values[i] << bitsavailable;
+    bitsavailable += 11;
+    while (bitsavailable >= 8) {
+      *out++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  return out;
+}
+
+static void randomChannelOutputs()
+{
+  for (int i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    // includes values out of the [-1024:+1024] range
+    channelOutputs[i] = (rand() % 3000) - 1500;
+  }
+}
+
+TEST(Pulses, pack11BitsChannels)
+{
+  uint16_t values[16];
+  uint8_t expected[22];
+  uint8_t packed[22];
+
+  srand(37);
+  for (int test = 0; test < 1000; test++) {
+    for (int i = 0; i < 16; i++) {
+      values[i] = test < 2 ? test * 2047 : rand() & 0x7FF;
+    }
+    packChannelsReference(expected, values, 16);
+    pack11BitsChannels(&packed[0], &values[0]);
+    pack11BitsChannels(&packed[11], &values[8]);
+    ASSERT_EQ(0, memcmp(expected, packed, sizeof(packed))) << "test " << test;
+  }
+}
+
+#if defined(SBUS) || defined(MULTIMODULE)
+static void resetSbusPulses()
+{
+  extmodulePulsesData.dsm2.index = 0;
+  extmodulePulsesData.dsm2.ptr = extmodulePulsesData.dsm2.pulses;
+}
+
+static bool sameSbusPulses(const Dsm2PulsesData & expected)
+{
+  const Dsm2PulsesData & actual = extmodulePulsesData.dsm2;
+  return (expected.ptr - expected.pulses) == (actual.ptr - actual.pulses) &&
+         expected.index == actual.index &&
+         !memcmp(expected.pulses, actual.pulses,
+                 (actual.ptr - actual.pulses) * sizeof(pulse_duration_t));
+}
+#endif
+
+#if defined(SBUS)
+// setupPulsesSbus() as it was before pack11BitsChannels()
+static void setupPulsesSbusReference()
+{
+  resetSbusPulses();
+  sendByteSbus(0x0F);
+
+  uint16_t values[16];
+  for (int i = 0; i < 16; i++) {
+    int value = channelOutputs[i] * 8 / 10 + 992;
+    values[i] = limit(0, value, 2047);
+  }
+  uint8_t channels[22];
+  packChannelsReference(channels, values, 16);
+  for (unsigned i = 0; i < sizeof(channels); i++) {
+    sendByteSbus(channels[i]);
+  }
+
+  sendByteSbus(0x00); // flags, channels 17 and 18 are <= 0
+  sendByteSbus(0x00);
+
+  if (extmodulePulsesData.dsm2.index & 1)
+    *extmodulePulsesData.dsm2.ptr++ = 255;
+  else
+    *(extmodulePulsesData.dsm2.ptr - 1) = 255;
+}
+
+TEST(Pulses, sbusFrame)
+{
+  MODEL_RESET();
+  srand(37);
+  for (int test = 0; test < 200; test++) {
+    randomChannelOutputs();
+    channelOutputs[16] = channelOutputs[17] = -1;
+
+    setupPulsesSbusReference();
+    Dsm2PulsesData expected = extmodulePulsesData.dsm2;
+    expected.ptr = expected.pulses + (extmodulePulsesData.dsm2.ptr - extmodulePulsesData.dsm2.pulses);
+
+    setupPulsesSbus();
+    ASSERT_TRUE(sameSbusPulses(expected)) << "test " << test;
+  }
+}
+#endif
+
+#if defined(MULTIMODULE)
+void sendChannels(uint8_t moduleIdx);
+
+// sendChannels() as it was before pack11BitsChannels()
+static void sendChannelsReference()
+{
+  uint16_t values[16];
+  for (int i = 0; i < 16; i++) {
+    int value = channelOutputs[i] * 800 / 1000 + 1024;
+    values[i] = limit(0, value, 2047);
+  }
+  uint8_t channels[22];
+  packChannelsReference(channels, values, 16);
+  for (unsigned i = 0; i < sizeof(channels); i++) {
+    sendByteSbus(channels[i]);
+  }
+}
+
+TEST(Pulses, multiChannels)
+{
+  MODEL_RESET();
+  srand(37);
+  for (int test = 0; test < 200; test++) {
+    randomChannelOutputs();
+
+    resetSbusPulses();
+    sendChannelsReference();
+    Dsm2PulsesData expected = extmodulePulsesData.dsm2;
+    expected.ptr = expected.pulses + (extmodulePulsesData.dsm2.ptr - extmodulePulsesData.dsm2.pulses);
+
+    resetSbusPulses();
+    sendChannels(EXTERNAL_MODULE);
+    ASSERT_TRUE(sameSbusPulses(expected)) << "test " << test;
+  }
+}
+#endif
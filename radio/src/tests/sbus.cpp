@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(SBUS_TRAINER)
+
+#define SBUS_CH_CENTER 0x3E0
+
+static void createSbusFrame(uint8_t * frame, const uint16_t * channels)
+{
+  memset(frame, 0, SBUS_FRAME_SIZE);
+  frame[0] = 0x0F;
+
+  uint32_t bits = 0;
+  uint32_t bitsavailable = 0;
+  uint8_t * p = &frame[1];
+  for (int i = 0; i < 16; i++) {
+    bits |= (uint32_t)channels[i] << bitsavailable;
+    bitsavailable += 11;
+    while (bitsavailable >= 8) {
+      *p++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+}
+
+static uint8_t testFrame[SBUS_FRAME_SIZE];
+static uint32_t testFrameIdx;
+
+static int testFrameGetByte(uint8_t * byte)
+{
+  if (testFrameIdx >= SBUS_FRAME_SIZE) return 0;
+  *byte = testFrame[testFrameIdx++];
+  return 1;
+}
+
+static int fakeAuxGetByte(void *, uint8_t * byte)
+{
+  return testFrameGetByte(byte);
+}
+
+// as the AUX serial driver does: one byte per receive callback
+static void receiveTestFrame(uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    sbusAuxReceiveData(&testFrame[i % SBUS_FRAME_SIZE], 1);
+  }
+}
+
+class SbusTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    uint16_t channels[16];
+    for (int i = 0; i < 16; i++) {
+      channels[i] = SBUS_CH_CENTER + (i - 8) * 100;
+    }
+    createSbusFrame(testFrame, channels);
+    testFrameIdx = 0;
+    memset(ppmInput, 0, sizeof(ppmInput));
+    ppmInputValidityTimer = 0;
+  }
+
+  void TearDown() override
+  {
+    sbusSetGetByte(nullptr);
+    sbusSetAuxGetByte(nullptr, nullptr);
+  }
+
+  void checkPpmInput()
+  {
+    for (int i = 0; i < MAX_TRAINER_CHANNELS; i++) {
+      EXPECT_EQ((i - 8) * 100 * 5 / 8, ppmInput[i]);
+    }
+    EXPECT_EQ(PPM_IN_VALID_TIMEOUT, ppmInputValidityTimer);
+  }
+};
+
+TEST_F(SbusTest, frameDecodedOnReception)
+{
+  sbusSetAuxGetByte(nullptr, nullptr);
+  sbusSetGetByte(sbusAuxGetByte);
+
+  receiveTestFrame(SBUS_FRAME_SIZE);
+  uint16_t start = getTmr2MHz();
+  sbusAuxFrameEnd();
+  uint16_t latency = getTmr2MHz() - start;
+
+  checkPpmInput();
+  TRACE("SBUS frame input latency: %d us", latency / 2);
+}
+
+TEST_F(SbusTest, frameIgnoredWhenNotTrainerInput)
+{
+  sbusSetGetByte(nullptr);
+  receiveTestFrame(SBUS_FRAME_SIZE);
+  sbusAuxFrameEnd();
+  EXPECT_EQ(0, ppmInput[0]);
+  EXPECT_EQ(0, ppmInputValidityTimer);
+}
+
+TEST_F(SbusTest, badFrameLengthIgnored)
+{
+  sbusSetGetByte(sbusAuxGetByte);
+
+  receiveTestFrame(SBUS_FRAME_SIZE - 1);
+  sbusAuxFrameEnd();
+  EXPECT_EQ(0, ppmInputValidityTimer);
+
+  receiveTestFrame(SBUS_FRAME_SIZE + 1);
+  sbusAuxFrameEnd();
+  EXPECT_EQ(0, ppmInputValidityTimer);
+
+  // the next frame starts from scratch
+  receiveTestFrame(SBUS_FRAME_SIZE);
+  sbusAuxFrameEnd();
+  checkPpmInput();
+}
+
+TEST_F(SbusTest, byteInputDecodedAfterFrameGap)
+{
+  sbusSetAuxGetByte(nullptr, fakeAuxGetByte);
+  sbusSetGetByte(sbusAuxGetByte);
+
+  uint16_t start = getTmr2MHz();
+  while (!ppmInputValidityTimer) {
+    processSbusInput();
+  }
+  uint16_t latency = getTmr2MHz() - start;
+
+  checkPpmInput();
+  TRACE("SBUS byte input latency: %d us", latency / 2);
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "usb_joystick.h"
+
+// usbJoystickUpdate() as it was before usbJoystickPackReport()
+static void packReportReference(uint8_t * report, const int16_t * channels)
+{
+  report[0] = 0;
+  report[1] = 0;
+  report[2] = 0;
+  for (int i = 0; i < 8; ++i) {
+    if (channels[i + 8] > 0) {
+      report[0] |= (1 << i);
+    }
+    if (channels[i + 16] > 0) {
+      report[1] |= (1 << i);
+    }
+    if (channels[i + 24] > 0) {
+      report[2] |= (1 << i);
+    }
+  }
+
+  for (int i = 0; i < 8; ++i) {
+    int16_t value = channels[i] + 1024;
+    if (value > 2047) value = 2047;
+    else if (value < 0) value = 0;
+    report[i * 2 + 3] = static_cast<uint8_t>(value & 0xFF);
+    report[i * 2 + 4] = static_cast<uint8_t>((value >> 8) & 0x07);
+  }
+}
+
+static void randomChannels(int16_t * channels, int count)
+{
+  for (int i = 0; i < count; i++) {
+    // includes values out of the [-1024:+1024] range
+    channels[i] = (rand() % 3000) - 1500;
+  }
+}
+
+TEST(UsbJoystick, reportLayout)
+{
+  int16_t channels[32];
+  uint8_t expected[19];
+  uint8_t report[19];
+
+  srand(37);
+  for (int test = 0; test < 1000; test++) {
+    randomChannels(channels, 32);
+    packReportReference(expected, channels);
+    ASSERT_EQ(sizeof(report), usbJoystickPackReport(report, &channels[0], 8, &channels[8], 24));
+    ASSERT_EQ(0, memcmp(expected, report, sizeof(report))) << "test " << test;
+  }
+}
+
+TEST(UsbJoystick, maxAxesAndButtons)
+{
+  int16_t axes[USB_JOYSTICK_MAX_AXES];
+  int16_t buttons[USB_JOYSTICK_MAX_BUTTONS];
+  uint8_t report[USB_JOYSTICK_REPORT_SIZE(USB_JOYSTICK_MAX_AXES, USB_JOYSTICK_MAX_BUTTONS)];
+
+  ASSERT_EQ(36u, sizeof(report));
+
+  srand(37);
+  for (int test = 0; test < 1000; test++) {
+    randomChannels(axes, USB_JOYSTICK_MAX_AXES);
+    randomChannels(buttons, USB_JOYSTICK_MAX_BUTTONS);
+    ASSERT_EQ(sizeof(report), usbJoystickPackReport(report, axes, USB_JOYSTICK_MAX_AXES,
+                                                    buttons, USB_JOYSTICK_MAX_BUTTONS));
+
+    for (int i = 0; i < USB_JOYSTICK_MAX_BUTTONS; i++) {
+      EXPECT_EQ(buttons[i] > 0, (report[i / 8] >> (i % 8)) & 1) << "button " << i;
+    }
+    for (int i = 0; i < USB_JOYSTICK_MAX_AXES; i++) {
+      int value = report[4 + 2 * i] + (report[5 + 2 * i] << 8);
+      EXPECT_EQ(limit(0, axes[i] + 1024, 2047), value) << "axis " << i;
+    }
+  }
+
+  // the ends of the range
+  for (int i = 0; i < USB_JOYSTICK_MAX_AXES; i++) {
+    axes[i] = (i & 1) ? 1024 : -1024;
+  }
+  for (int i = 0; i < USB_JOYSTICK_MAX_BUTTONS; i++) {
+    buttons[i] = 1;
+  }
+  usbJoystickPackReport(report, axes, USB_JOYSTICK_MAX_AXES, buttons, USB_JOYSTICK_MAX_BUTTONS);
+  EXPECT_EQ(0xFFFFFFFF, report[0] | (report[1] << 8) | (report[2] << 16) | ((uint32_t)report[3] << 24));
+  EXPECT_EQ(0, report[4] | (report[5] << 8));
+  EXPECT_EQ(2047, report[6] | (report[7] << 8));
+}
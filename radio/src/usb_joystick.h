@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _USB_JOYSTICK_H_
+#define _USB_JOYSTICK_H_
+
+#include <inttypes.h>
+
+#define USB_JOYSTICK_MAX_AXES     16
+#define USB_JOYSTICK_MAX_BUTTONS  32
+
+// Size of a report with the given number of axes and buttons
+#define USB_JOYSTICK_REPORT_SIZE(axes, buttons)  (((buttons) + 7) / 8 + 2 * (axes))
+
+// Packs a joystick report, as described by the HID report descriptor:
+// - the buttons, 1 bit each, LSB first, on when the channel is > 0
+// - the axes, 11 bits in 16 bits little endian, from 0 (-100%) to 2047 (+100%)
+// Returns the size of the report
+inline uint8_t usbJoystickPackReport(uint8_t * report,
+                                     const int16_t * axes, uint8_t axesCount,
+                                     const int16_t * buttons, uint8_t buttonsCount)
+{
+  uint8_t * ptr = report;
+
+  uint32_t bits = 0;
+  for (uint8_t i = 0; i < buttonsCount; i++) {
+    if (buttons[i] > 0) {
+      bits |= (uint32_t)1 << i;
+    }
+  }
+  for (uint8_t i = 0; i < buttonsCount; i += 8) {
+    *ptr++ = bits >> i;
+  }
+
+  for (uint8_t i = 0; i < axesCount; i++) {
+    int value = axes[i] + 1024;
+    if (value > 2047)
+      value = 2047;
+    else if (value < 0)
+      value = 0;
+    *ptr++ = value;
+    *ptr++ = value >> 8;
+  }
+
+  return ptr - report;
+}
+
+#endif // _USB_JOYSTICK_H_